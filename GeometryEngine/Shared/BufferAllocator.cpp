@@ -0,0 +1,215 @@
+#include "BufferAllocator.hpp"
+
+const size_t BufferAllocator::INITIAL_VERTEX_COUNT = 1 << 16;
+const size_t BufferAllocator::INITIAL_INDEX_SIZE = 1 << 20;
+const size_t BufferAllocator::INDEX_ALIGNMENT = 4;
+
+
+BufferAllocator::~BufferAllocator() {
+	for (std::map<UInt, Pool>::iterator iter = pools.begin(); iter != pools.end(); ++iter) {
+		glDeleteVertexArrays(1, &iter->second.VAO);
+		glDeleteBuffers(1, &iter->second.VBO);
+		glDeleteBuffers(1, &iter->second.EBO);
+	}
+
+	pools.clear();
+}
+
+BufferRange BufferAllocator::allocate(const UInt& format, const void* vertex_data, const size_t& vertex_count, const void* index_data, const size_t& index_size) {
+	BufferRange range;
+	range.format = format;
+	if (vertex_count == 0) { return range; }
+
+	Pool& pool = get_pool(format);
+	const size_t stride = get_stride(format);
+
+	size_t vertex_offset = 0;
+	if (!pool.vertices.allocate(vertex_count, vertex_offset)) {
+		const size_t old_capacity = pool.vertices.get_capacity();
+		const size_t new_capacity = std::max(old_capacity * 2, old_capacity + vertex_count);
+
+		pool.VBO = resize_buffer(pool.VBO, old_capacity * stride, new_capacity * stride);
+		pool.vertices.grow(new_capacity);
+		pool.vertices.allocate(vertex_count, vertex_offset);
+		set_up_vertex_array(pool, format);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+	glBufferSubData(GL_ARRAY_BUFFER, vertex_offset * stride, vertex_count * stride, vertex_data);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	range.first_vertex = static_cast<UInt>(vertex_offset);
+	range.vertex_count = static_cast<UInt>(vertex_count);
+
+	if (index_data && (index_size > 0)) {
+		const size_t aligned_size = ((index_size + INDEX_ALIGNMENT - 1) / INDEX_ALIGNMENT) * INDEX_ALIGNMENT;
+
+		size_t index_offset = 0;
+		if (!pool.indices.allocate(aligned_size, index_offset)) {
+			const size_t old_capacity = pool.indices.get_capacity();
+			const size_t new_capacity = std::max(old_capacity * 2, old_capacity + aligned_size);
+
+			pool.EBO = resize_buffer(pool.EBO, old_capacity, new_capacity);
+			pool.indices.grow(new_capacity);
+			pool.indices.allocate(aligned_size, index_offset);
+			set_up_vertex_array(pool, format);
+		}
+
+		// Uploaded through the copy target so the element buffer binding of whichever VAO is bound is left alone
+		glBindBuffer(GL_COPY_WRITE_BUFFER, pool.EBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, index_offset, index_size, index_data);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		range.index_offset = index_offset;
+		range.index_size = aligned_size;
+	}
+
+	return range;
+}
+
+void BufferAllocator::free(BufferRange& range) {
+	if (!range.is_allocated()) { return; }
+
+	std::map<UInt, Pool>::iterator found = pools.find(range.format);
+	if (found != pools.end()) {
+		found->second.vertices.free(range.first_vertex, range.vertex_count);
+		if (range.index_size > 0) { found->second.indices.free(range.index_offset, range.index_size); }
+	}
+
+	range = BufferRange();
+}
+
+void BufferAllocator::bind(const UInt& format) {
+	glBindVertexArray(get_pool(format).VAO);
+}
+
+BufferAllocator::Pool& BufferAllocator::get_pool(const UInt& format) {
+	std::map<UInt, Pool>::iterator found = pools.find(format);
+	if (found != pools.end()) { return found->second; }
+
+	Pool& pool = pools[format];
+	glGenVertexArrays(1, &pool.VAO);
+
+	pool.VBO = resize_buffer(0, 0, INITIAL_VERTEX_COUNT * get_stride(format));
+	pool.vertices.grow(INITIAL_VERTEX_COUNT);
+	pool.EBO = resize_buffer(0, 0, INITIAL_INDEX_SIZE);
+	pool.indices.grow(INITIAL_INDEX_SIZE);
+
+	set_up_vertex_array(pool, format);
+	return pool;
+}
+
+void BufferAllocator::set_up_vertex_array(Pool& pool, const UInt& format) {
+	// Attribute pointers hold on to the buffer they were made with, so they are remade whenever a buffer is replaced
+	glBindVertexArray(pool.VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.EBO);
+
+	const int stride = static_cast<int>(get_stride(format));
+
+	switch (format) {
+		case (VertexFormats::STANDARD) : {
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, nullptr);
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+			glEnableVertexAttribArray(2);
+			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+			break;
+		}
+
+		case (VertexFormats::COMPACT) : {
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, nullptr);
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(CompactVertex, normal));
+			glEnableVertexAttribArray(2);
+			glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(CompactVertex, texture_coords));
+			break;
+		}
+
+		case (VertexFormats::QUANTISED) : {
+			// Not normalised, integers convert to floats exactly and the scale lives in the model matrix
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_SHORT, GL_FALSE, stride, nullptr);
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(QuantisedVertex, normal));
+			glEnableVertexAttribArray(2);
+			glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(QuantisedVertex, texture_coords));
+			break;
+		}
+
+		default: { throw std::runtime_error("Unknown vertex format " + std::to_string(format)); }
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+size_t BufferAllocator::get_stride(const UInt& format) {
+	switch (format) {
+		case (VertexFormats::STANDARD) : { return 8 * sizeof(float); }
+		case (VertexFormats::COMPACT) : { return sizeof(CompactVertex); }
+		case (VertexFormats::QUANTISED) : { return sizeof(QuantisedVertex); }
+		default: { throw std::runtime_error("Unknown vertex format " + std::to_string(format)); }
+	}
+}
+
+UInt BufferAllocator::resize_buffer(const UInt& buffer, const size_t& old_size, const size_t& new_size) {
+	UInt new_buffer = 0;
+	glGenBuffers(1, &new_buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, new_buffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, new_size, nullptr, GL_STATIC_DRAW);
+
+	if (buffer && (old_size > 0)) {
+		glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, old_size);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &buffer);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return new_buffer;
+}
+
+bool BufferAllocator::FreeList::allocate(const size_t& size, size_t& offset) {
+	for (std::map<size_t, size_t>::iterator iter = blocks.begin(); iter != blocks.end(); ++iter) {
+		if (iter->second < size) { continue; }
+
+		offset = iter->first;
+		const size_t remaining = iter->second - size;
+		blocks.erase(iter);
+
+		if (remaining > 0) { blocks[offset + size] = remaining; }
+		return true;
+	}
+
+	return false;
+}
+
+void BufferAllocator::FreeList::free(const size_t& offset, const size_t& size) {
+	std::map<size_t, size_t>::iterator inserted = blocks.insert({ offset, size }).first;
+
+	// Merge with the following block, then the preceding one
+	std::map<size_t, size_t>::iterator next = std::next(inserted);
+	if ((next != blocks.end()) && (inserted->first + inserted->second == next->first)) {
+		inserted->second += next->second;
+		blocks.erase(next);
+	}
+
+	if (inserted != blocks.begin()) {
+		std::map<size_t, size_t>::iterator previous = std::prev(inserted);
+		if (previous->first + previous->second == inserted->first) {
+			previous->second += inserted->second;
+			blocks.erase(inserted);
+		}
+	}
+}
+
+void BufferAllocator::FreeList::grow(const size_t& new_capacity) {
+	if (new_capacity <= capacity) { return; }
+
+	const size_t old_capacity = capacity;
+	capacity = new_capacity;
+	free(old_capacity, new_capacity - old_capacity);
+}
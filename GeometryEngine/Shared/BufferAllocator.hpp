@@ -0,0 +1,108 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+namespace VertexFormats {
+	// Interleaved position, normal and texture coordinates, 8 floats per vertex (MeshVertex and Shape's vertices)
+	static const UInt STANDARD = 0;
+
+	// Float position, GL_INT_2_10_10_10_REV normal and half float texture coordinates (CompactVertex)
+	static const UInt COMPACT = 1;
+
+	// As COMPACT with 16 bit integer positions, which the model matrix must dequantise (QuantisedVertex)
+	static const UInt QUANTISED = 2;
+}
+
+struct CompactVertex {
+	float position[3];
+	UInt normal;
+	UShort texture_coords[2];
+};
+
+struct QuantisedVertex {
+	short position[4];	// The fourth is padding, attributes are kept 4 byte aligned
+	UInt normal;
+	UShort texture_coords[2];
+};
+
+struct BufferRange {
+	UInt format = VertexFormats::STANDARD;
+	UInt first_vertex = 0;		// Also the base vertex of indexed draws
+	UInt vertex_count = 0;
+	size_t index_offset = 0;	// In bytes, within the format's element buffer
+	size_t index_size = 0;		// In bytes
+
+	inline bool is_allocated() const { return vertex_count != 0; }
+};
+
+
+class BufferAllocator {
+	/*
+	Carves vertex and index ranges out of one large vertex and element buffer per vertex format
+
+	Every range of a format is drawn through that format's one VAO, using its first vertex with
+	glDrawArrays or as the base vertex of glDrawElementsBaseVertex, so creating and destroying
+	shapes makes no GL objects and switching between them doesn't switch VAO. Free space is kept
+	as a first-fit free list per buffer, neighbouring blocks are merged again when a range is freed.
+
+	A full buffer is replaced by one twice the size and its contents copied across, so ranges never move
+	*/
+
+public:
+	static BufferAllocator& get_instance() {
+		static BufferAllocator instance;
+		return instance;
+	}
+
+	BufferAllocator(const BufferAllocator& other) = delete;
+	void operator=(const BufferAllocator& other) = delete;
+
+	// Index data is optional, shapes drawn with glDrawArrays have none
+	BufferRange allocate(const UInt& format, const void* vertex_data, const size_t& vertex_count, const void* index_data = nullptr, const size_t& index_size = 0);
+
+	// Safe to call with a range that was never allocated, the range is reset
+	void free(BufferRange& range);
+
+	// Binds the format's VAO, with its element buffer
+	void bind(const UInt& format);
+
+private:
+	class FreeList {
+	public:
+		inline size_t get_capacity() const { return capacity; }
+
+		bool allocate(const size_t& size, size_t& offset);
+		void free(const size_t& offset, const size_t& size);
+		void grow(const size_t& new_capacity);
+
+	private:
+		std::map<size_t, size_t> blocks;	// Offset to size
+		size_t capacity = 0;
+	};
+
+	struct Pool {
+		UInt VAO = 0;
+		UInt VBO = 0;
+		UInt EBO = 0;
+
+		FreeList vertices;	// Counted in vertices
+		FreeList indices;	// Counted in bytes
+	};
+
+	static const size_t INITIAL_VERTEX_COUNT;
+	static const size_t INITIAL_INDEX_SIZE;
+
+	// Index ranges start on this many bytes, so any index type can be read from them
+	static const size_t INDEX_ALIGNMENT;
+
+	std::map<UInt, Pool> pools;
+
+	inline BufferAllocator() {}
+	~BufferAllocator();
+
+	Pool& get_pool(const UInt& format);
+	void set_up_vertex_array(Pool& pool, const UInt& format);
+
+	static size_t get_stride(const UInt& format);
+	static UInt resize_buffer(const UInt& buffer, const size_t& old_size, const size_t& new_size);
+};
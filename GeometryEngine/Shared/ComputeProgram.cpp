@@ -0,0 +1,29 @@
+#include "ComputeProgram.hpp"
+
+
+ComputeProgram::ComputeProgram(const std::string& compute_shader_path) : Program() {
+	if (!boost::filesystem::exists(compute_shader_path)) { throw std::runtime_error(compute_shader_path + " does not exist"); }
+
+#ifdef GL_COMPUTE_SHADER
+	std::ifstream compute_file_stream(compute_shader_path);
+	const std::string compute_file_string((std::istreambuf_iterator<char>(compute_file_stream)), std::istreambuf_iterator<char>());
+
+	const UInt compute_id = _compile_shader_string(GL_COMPUTE_SHADER, compute_file_string);
+	const UInt program_id = glCreateProgram();
+	glAttachShader(program_id, compute_id);
+	glLinkProgram(program_id);
+	check_link_status(program_id);
+	glDeleteShader(compute_id);
+
+	_program_id = program_id;
+#else
+	throw std::runtime_error("Compute shaders are not available on this platform");
+#endif
+}
+
+void ComputeProgram::dispatch(const UInt& group_count_x, const UInt& group_count_y, const UInt& group_count_z) {
+#ifdef GL_COMPUTE_SHADER
+	use();
+	glDispatchCompute(group_count_x, group_count_y, group_count_z);
+#endif
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Program.hpp"
+
+
+class ComputeProgram : public Program {
+	/*
+	Program made of a single compute shader, run with dispatch() rather than by drawing
+
+	Compute shaders are core from 4.3, only create these when the context supports it
+	*/
+
+public:
+	ComputeProgram(const ComputeProgram& other) = delete;
+	void operator=(const ComputeProgram& other) = delete;
+
+	ComputeProgram(const std::string& compute_shader_path);
+	virtual ~ComputeProgram() {}
+
+	// Invocations are grouped by the shader's local size, so this is the number of work groups
+	void dispatch(const UInt& group_count_x, const UInt& group_count_y = 1, const UInt& group_count_z = 1);
+};
@@ -12,8 +12,10 @@ public:
 	virtual ~Cube();
 
     virtual void render(const SHADER_ID& id);
+	virtual bool is_transparent();
 
     virtual inline void set_texture(const UInt& new_tex) { texture = new_tex; }
+	inline UInt get_texture() const { return texture; }
             
 protected:
 	virtual void evaluate_changed();
@@ -75,12 +75,14 @@ void Cuboid::render(const SHADER_ID& id) {
 	program.set_uniform<int>("material.texture_diffuse", 0);
 	program.set_uniform<int>("material.texture_specular", 0);
 
-	glBindVertexArray(_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 36);
+	const bool blending_enabled = enable_blending();
+
+	BufferAllocator::get_instance().bind(_buffer_range.format);
+	glDrawArrays(GL_TRIANGLES, _buffer_range.first_vertex, 36);
 	glBindVertexArray(0);
 
 	glBindTexture(GL_TEXTURE_2D, 0);
-
+	if (blending_enabled) { glDisable(GL_BLEND); }
 }
 
 void Cuboid::operator=(const Cuboid& other){
@@ -94,25 +96,9 @@ void Cuboid::evaluate_changed() {
 	if (!_needs_evaluation) { return; }
 	_needs_evaluation = false;
 
-	glDeleteVertexArrays(1, &_VAO);
-	glDeleteBuffers(1, &_VBO);
-
-	glGenVertexArrays(1, &_VAO);
-	glBindVertexArray(_VAO);
-
-	glGenBuffers(1, &_VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
-
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), nullptr);
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	BufferAllocator& allocator = BufferAllocator::get_instance();
+	allocator.free(_buffer_range);
+	_buffer_range = allocator.allocate(VertexFormats::STANDARD, &vertices[0], vertices.size() / 8);
 }
 
 bool Cuboid::does_collide(const Collidable& other) {
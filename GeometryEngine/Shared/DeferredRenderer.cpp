@@ -0,0 +1,163 @@
+#include "DeferredRenderer.hpp"
+#include "ResourceHandler.hpp"
+
+
+DeferredRenderer::DeferredRenderer(const UInt& width, const UInt& height) :
+g_buffer(width, height, {
+	{ GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },	// Albedo (rgb) + specular intensity (a)
+	{ GL_RGBA16F, GL_RGBA, GL_FLOAT },			// Normal (rgb) + shininess (a)
+	{ GL_RGBA32F, GL_RGBA, GL_FLOAT },			// World position (rgb) + coverage (a)
+	{ GL_RGBA16F, GL_RGBA, GL_FLOAT }			// Lit result
+}) {}
+
+void DeferredRenderer::begin_geometry_pass(const mat4& vp, const UInt& width, const UInt& height) {
+	g_buffer.resize(width, height);
+	g_buffer.bind();
+
+	// Coverage is cleared to 0 so the light pass can skip pixels nothing was drawn to
+	float clear_colour[4];
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_colour);
+
+	g_buffer.draw_to_all();
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glClearColor(clear_colour[0], clear_colour[1], clear_colour[2], clear_colour[3]);
+
+	g_buffer.draw_to({ ALBEDO_SPECULAR, NORMAL_SHININESS, POSITION });
+
+	// Alpha channels hold data here, not transparency
+	glDisable(GL_BLEND);
+
+	ResourceHandler::get_instance().get_program(GEOMETRY_ID()).set_uniform<mat4>("VP", vp);
+}
+
+void DeferredRenderer::light_pass(LightMapProgram& light_program, const mat4& vp, const vec3& view_position, const UInt& shadow_cube_map, const bool use_shadows, const float& far_plane) {
+	LightMapProgram& program = dynamic_cast<LightMapProgram&>(ResourceHandler::get_instance().get_program(LIGHTING_ID()));
+
+	// Light colour and filtering taps follow the forward program, so the quality governor applies to both paths
+	program.set_feature(LightMapFeatures::LIGHT_COLOUR, light_program.has_feature(LightMapFeatures::LIGHT_COLOUR));
+	program.set_quality_tier(light_program.get_quality_tier());
+
+	g_buffer.draw_to({ ACCUMULATION });
+
+	g_buffer.bind_colour_texture(ALBEDO_SPECULAR, 1);
+	g_buffer.bind_colour_texture(NORMAL_SHININESS, 2);
+	g_buffer.bind_colour_texture(POSITION, 3);
+
+	glActiveTexture(GL_TEXTURE31);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, shadow_cube_map);
+
+	// Replayed onto the shadowed variant and back as the lights switch between them
+	program.set_persistent_uniform<int>("g_albedo_specular", 1);
+	program.set_persistent_uniform<int>("g_normal_shininess", 2);
+	program.set_persistent_uniform<int>("g_position", 3);
+	program.set_persistent_uniform<int>("depth_map", 31);
+
+	program.set_persistent_uniform<mat4>("VP", vp);
+	program.set_persistent_uniform<vec3>("view_position", view_position);
+	program.set_persistent_uniform<float>("far_plane", far_plane);
+	program.set_persistent_uniform<vec2>("screen_size", vec2(static_cast<float>(g_buffer.get_width()), static_cast<float>(g_buffer.get_height())));
+
+	// Back faces of each volume are drawn without depth testing, so pixels are still lit when the camera is inside a volume
+	glDisable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+	glCullFace(GL_FRONT);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE);
+
+	for (size_t light_iter = 0; light_iter < light_program.get_light_count(); ++light_iter) {
+		const PointLight* light = light_program.get_light(light_iter);
+
+		// Only the first light has a shadow map, matching the forward shader
+		program.set_feature(LightMapFeatures::SHADOWS, (light_iter == 0) && use_shadows);
+
+		program.set_uniform<vec3>("light.position", light->position);
+		program.set_uniform<vec3>("light.light_colour", light->light_colour);
+		program.set_uniform<float>("light.constant_val", light->constant_val);
+		program.set_uniform<float>("light.linear_val", light->linear_val);
+		program.set_uniform<float>("light.quadratic", light->quadratic);
+		program.set_uniform<vec3>("light.ambient", light->ambient);
+		program.set_uniform<vec3>("light.diffuse", light->diffuse);
+		program.set_uniform<vec3>("light.specular", light->specular);
+
+		const float radius = get_light_radius(*light, far_plane);
+
+		// A volume past the far plane would be clipped and one around the camera has nothing in front to shade through,
+		// so either is drawn over the whole screen instead (the corner of the cube being the furthest point)
+		const vec3 offset = view_position - light->position;
+		const bool camera_inside = (std::abs(offset.x) <= radius) && (std::abs(offset.y) <= radius) && (std::abs(offset.z) <= radius);
+		const bool past_far_plane = (length(offset) + (radius * std::sqrt(3.0f))) >= far_plane;
+
+		if (camera_inside || past_far_plane) {
+			program.set_uniform<bool>("fullscreen", true);
+
+			// The triangle faces the camera, unlike the back faces of a volume
+			glCullFace(GL_BACK);
+			RenderTarget::draw_fullscreen();
+			glCullFace(GL_FRONT);
+
+			program.set_uniform<bool>("fullscreen", false);
+			continue;
+		}
+
+		light_volume.set_position(light->position);
+		light_volume.set_enlargement(vec3(radius * 2.0f));
+		light_volume.render(LIGHTING_ID());
+	}
+
+	glDisable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glCullFace(GL_BACK);
+	glDepthMask(GL_TRUE);
+	glEnable(GL_DEPTH_TEST);
+
+	for (UInt unit = 1; unit <= 3; ++unit) {
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	glActiveTexture(GL_TEXTURE0);
+}
+
+void DeferredRenderer::begin_forward_pass() {
+	// The G-buffer depth is still attached, so forward geometry is occluded correctly
+	g_buffer.bind();
+	g_buffer.draw_to({ ACCUMULATION });
+}
+
+void DeferredRenderer::composite(const UInt& width, const UInt& height, const RenderTarget* destination) {
+	if (destination) { destination->bind(); }
+	else {
+		RenderTarget::unbind();
+		glViewport(0, 0, width, height);
+	}
+
+	Program& program = ResourceHandler::get_instance().get_program(COMPOSITE_ID());
+	g_buffer.bind_colour_texture(ACCUMULATION, 0);
+	program.set_uniform<int>("scene", 0);
+
+	glDisable(GL_DEPTH_TEST);
+	RenderTarget::draw_fullscreen();
+	glEnable(GL_DEPTH_TEST);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+float DeferredRenderer::get_light_radius(const PointLight& light, const float& max_radius) {
+	// Distance at which the brightest channel attenuates to roughly 1/256
+	const float brightest = std::max(std::max(light.diffuse.x, light.diffuse.y), light.diffuse.z);
+	const float threshold = 256.0f * std::max(brightest, 1.0f);
+
+	float radius;
+
+	if (light.quadratic > 0.0f) {
+		const float discriminant = (light.linear_val * light.linear_val) - (4.0f * light.quadratic * (light.constant_val - threshold));
+		radius = (-light.linear_val + std::sqrt(discriminant)) / (2.0f * light.quadratic);
+
+	} else if (light.linear_val > 0.0f) {
+		radius = (threshold - light.constant_val) / light.linear_val;
+
+	} else { radius = max_radius; }
+
+	return std::min(radius, max_radius);
+}
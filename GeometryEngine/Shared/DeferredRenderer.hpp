@@ -0,0 +1,50 @@
+#pragma once
+#include "EngineHeader.hpp"
+#include "RenderTarget.hpp"
+#include "LightMapProgram.hpp"
+#include "Cube.hpp"
+
+
+class DeferredRenderer {
+	/*
+	Alternative to the forward LightMapProgram path
+
+	1. Geometry pass:	Meshes and cubes are drawn with GEOMETRY_ID into the G-buffer
+	2. Light pass:		Each PointLight is drawn as a cube volume, additively shading the pixels it covers
+						(or as a full screen triangle when the camera is inside its volume or it reaches the far plane)
+	3. Forward pass:	Anything not suited to the G-buffer (sky, text, exploding meshes) is drawn over the result
+	4. Composite:		The accumulated image is copied to the default framebuffer (or a post-processing target)
+
+	The lights themselves are still owned by the LightMapProgram so both paths share one scene setup.
+	LIGHTING_ID is a LightMapProgram too, given the forward program's light colour and quality tier
+	each frame, and the SHADOWS variant only for the first light
+	*/
+
+	// G-buffer attachment indices
+	static const size_t ALBEDO_SPECULAR = 0;
+	static const size_t NORMAL_SHININESS = 1;
+	static const size_t POSITION = 2;
+	static const size_t ACCUMULATION = 3;
+
+public:
+	inline static SHADER_ID GEOMETRY_ID() { return "DeferredGeometry"; }
+	inline static SHADER_ID LIGHTING_ID() { return "DeferredLighting"; }
+	inline static SHADER_ID COMPOSITE_ID() { return "DeferredComposite"; }
+
+public:
+	DeferredRenderer(const UInt& width, const UInt& height);
+
+	DeferredRenderer(const DeferredRenderer& other) = delete;
+	void operator=(const DeferredRenderer& other) = delete;
+
+	void begin_geometry_pass(const mat4& vp, const UInt& width, const UInt& height);
+	void light_pass(LightMapProgram& light_program, const mat4& vp, const vec3& view_position, const UInt& shadow_cube_map, const bool use_shadows, const float& far_plane);
+	void begin_forward_pass();
+	void composite(const UInt& width, const UInt& height, const RenderTarget* destination = nullptr);	// Default framebuffer without a destination
+
+	static float get_light_radius(const PointLight& light, const float& max_radius);
+
+private:
+	RenderTarget g_buffer;
+	Cube light_volume;
+};
@@ -0,0 +1,57 @@
+#include "FrameTimer.hpp"
+
+const float FrameTimer::SMOOTHING = 0.1f;
+
+
+FrameTimer::FrameTimer() {
+	glGenQueries(static_cast<int>(QUERY_COUNT), queries);
+	for (size_t iter = 0; iter < QUERY_COUNT; ++iter) { in_flight[iter] = false; }
+}
+
+FrameTimer::~FrameTimer() {
+	glDeleteQueries(static_cast<int>(QUERY_COUNT), queries);
+}
+
+void FrameTimer::begin_frame() {
+	collect_results();
+	cpu_start = glfwGetTime();
+
+	// Every query still being waited on means the GPU is several frames behind, this frame goes unmeasured
+	if (in_flight[current_query]) { return; }
+
+	glBeginQuery(GL_TIME_ELAPSED, queries[current_query]);
+	timing_gpu = true;
+}
+
+void FrameTimer::end_frame() {
+	cpu_time = smooth(cpu_time, static_cast<float>((glfwGetTime() - cpu_start) * 1000.0));
+
+	if (!timing_gpu) { return; }
+
+	glEndQuery(GL_TIME_ELAPSED);
+	in_flight[current_query] = true;
+	current_query = (current_query + 1) % QUERY_COUNT;
+	timing_gpu = false;
+}
+
+void FrameTimer::collect_results() {
+	for (size_t iter = 0; iter < QUERY_COUNT; ++iter) {
+		if (!in_flight[iter]) { continue; }
+
+		int available = 0;
+		glGetQueryObjectiv(queries[iter], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) { continue; }
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(queries[iter], GL_QUERY_RESULT, &elapsed);
+
+		gpu_time = smooth(gpu_time, static_cast<float>(elapsed / 1000000.0));
+		in_flight[iter] = false;
+	}
+}
+
+float FrameTimer::smooth(const float& average, const float& sample) {
+	// The first sample is taken as is, rather than climbing up from zero
+	if (average <= 0.0f) { return sample; }
+	return average + ((sample - average) * SMOOTHING);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+class FrameTimer {
+	/*
+	Measures how long each frame takes on the CPU and on the GPU, in milliseconds
+
+	begin_frame() and end_frame() are wrapped around everything a frame submits (not the buffer
+	swap, which waits for vsync). GPU time comes from GL_TIME_ELAPSED queries, several of which are
+	kept in flight and only read back once available, so measuring never stalls the pipeline.
+	Both times are smoothed over recent frames. Time elapsed queries cannot be nested, so nothing
+	else may start one between begin_frame() and end_frame()
+	*/
+
+public:
+	FrameTimer();
+	~FrameTimer();
+
+	FrameTimer(const FrameTimer& other) = delete;
+	void operator=(const FrameTimer& other) = delete;
+
+	void begin_frame();
+	void end_frame();
+
+	inline float get_cpu_time() const { return cpu_time; }
+	inline float get_gpu_time() const { return gpu_time; }
+
+private:
+	static const size_t QUERY_COUNT = 4;
+	static const float SMOOTHING;	// Weight given to the newest sample
+
+	UInt queries[QUERY_COUNT];
+	bool in_flight[QUERY_COUNT];
+	size_t current_query = 0;
+	bool timing_gpu = false;
+
+	double cpu_start = 0.0;
+	float cpu_time = 0.0f;
+	float gpu_time = 0.0f;
+
+	void collect_results();
+	static float smooth(const float& average, const float& sample);
+};
@@ -0,0 +1,34 @@
+#include "Frustum.hpp"
+
+
+Frustum::Frustum(const mat4& vp) {
+	// Matrices are column major, so each row is gathered across the columns
+	vec4 rows[4];
+	for (size_t row = 0; row < 4; ++row) {
+		rows[row] = vec4(vp[0][row], vp[1][row], vp[2][row], vp[3][row]);
+	}
+
+	planes[0] = rows[3] + rows[0];	// Left
+	planes[1] = rows[3] - rows[0];	// Right
+	planes[2] = rows[3] + rows[1];	// Bottom
+	planes[3] = rows[3] - rows[1];	// Top
+	planes[4] = rows[3] + rows[2];	// Near
+	planes[5] = rows[3] - rows[2];	// Far
+}
+
+bool Frustum::intersects_aabb(const vec3& aabb_min, const vec3& aabb_max) const {
+	for (size_t iter = 0; iter < planes.size(); ++iter) {
+		const vec4& plane = planes.at(iter);
+
+		// The corner furthest along the plane normal, if even that is behind the plane then so is the whole box
+		const vec3 furthest(
+			plane.x >= 0.0f ? aabb_max.x : aabb_min.x,
+			plane.y >= 0.0f ? aabb_max.y : aabb_min.y,
+			plane.z >= 0.0f ? aabb_max.z : aabb_min.z
+		);
+
+		if ((plane.x * furthest.x) + (plane.y * furthest.y) + (plane.z * furthest.z) + plane.w < 0.0f) { return false; }
+	}
+
+	return true;
+}
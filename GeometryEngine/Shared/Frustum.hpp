@@ -0,0 +1,20 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+class Frustum {
+	// View frustum planes extracted from a view-projection matrix (Gribb & Hartmann)
+
+public:
+	Frustum(const mat4& vp);
+
+	// Conservative, boxes near a frustum corner may be reported as intersecting when they are not
+	bool intersects_aabb(const vec3& aabb_min, const vec3& aabb_max) const;
+
+	// Unnormalised, for testing on the GPU
+	inline const std::array<vec4, 6>& get_planes() const { return planes; }
+
+private:
+	// xyz is the inward facing normal, w the distance
+	std::array<vec4, 6> planes;
+};
@@ -0,0 +1,146 @@
+#include "Impostor.hpp"
+#include "ResourceHandler.hpp"
+
+const float Impostor::MIN_ELEVATION = -static_cast<float>(M_PI) / 6.0f;
+const float Impostor::MAX_ELEVATION = static_cast<float>(M_PI) / 3.0f;
+
+
+Impostor::Impostor(const UInt& cell_size) :
+atlas(cell_size * AZIMUTH_STEPS, cell_size * ELEVATION_STEPS, { { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE } }),
+cell_size(cell_size) {
+
+	// Quads are minified at a distance, filtered texels hide the step between views
+	glBindTexture(GL_TEXTURE_2D, atlas.get_colour_texture(0));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &instance_buffer);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, centre_radius));
+	glVertexAttribDivisor(0, 1);
+
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, tint_fade_out));
+	glVertexAttribDivisor(1, 1);
+
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, cell));
+	glVertexAttribDivisor(2, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+Impostor::~Impostor() {
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &instance_buffer);
+}
+
+void Impostor::bake(Shape& shape, const SHADER_ID& id) {
+	std::vector<vec3> vertices = shape.get_personal_vertices();
+
+	float radius = 0.0f;
+	for (size_t iter = 0; iter < vertices.size(); ++iter) { radius = std::max(radius, length(vertices.at(iter))); }
+	if (radius <= 0.0f) { throw std::runtime_error("Cannot bake an impostor of an empty shape"); }
+
+	GLint viewport[4];
+	GLfloat clear_colour[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_colour);
+
+	// Transparent background, the impostor fragment shader cuts out anything the shape did not cover
+	atlas.bind();
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	Program& program = ResourceHandler::get_instance().get_program(id);
+	const mat4 projection = ortho(-radius, radius, -radius, radius, radius, radius * 3.0f);
+
+	for (UInt elevation = 0; elevation < ELEVATION_STEPS; ++elevation) {
+		for (UInt azimuth = 0; azimuth < AZIMUTH_STEPS; ++azimuth) {
+			const vec3 eye = get_view_direction(azimuth, elevation) * (radius * 2.0f);
+
+			program.set_persistent_uniform<mat4>("VP", projection * look_at(eye, vec3(0.0f), vec3(0.0f, 1.0f, 0.0f)));
+			program.set_persistent_uniform<vec3>("view_position", eye);
+
+			glViewport(azimuth * cell_size, elevation * cell_size, cell_size, cell_size);
+			shape.render(id);
+		}
+	}
+
+	RenderTarget::unbind();
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	glClearColor(clear_colour[0], clear_colour[1], clear_colour[2], clear_colour[3]);
+
+	baked = true;
+}
+
+void Impostor::add_instance(const vec3& centre, const quat& rotation, const float& radius, const vec3& tint, const float& fade_out) {
+	instances.push_back({ vec4(centre.x, centre.y, centre.z, radius), vec4(tint.x, tint.y, tint.z, fade_out), 0.0f });
+	rotations.push_back(rotation);
+}
+
+void Impostor::render(const mat4& view, const mat4& projection, const vec3& view_position) {
+	if (instances.empty()) { return; }
+	if (!baked) { throw std::runtime_error("Impostor must be baked before it is rendered"); }
+
+	// The view is chosen in the shape's own space, so a turned instance shows its turned side
+	for (size_t iter = 0; iter < instances.size(); ++iter) {
+		const quat& rotation = rotations.at(iter);
+		const quat inverse_rotation(rotation.w, -rotation.x, -rotation.y, -rotation.z);
+
+		const vec3 centre = to_vec3(instances.at(iter).centre_radius);
+		instances.at(iter).cell = static_cast<float>(get_closest_cell(inverse_rotation * (view_position - centre)));
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+	glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Instance), &instances[0], GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	Program& program = ResourceHandler::get_instance().get_program(GENERIC_ID());
+	program.set_uniform<mat4>("view", view);
+	program.set_uniform<mat4>("projection", projection);
+	program.set_uniform<vec2>("atlas_cells", vec2(static_cast<float>(AZIMUTH_STEPS), static_cast<float>(ELEVATION_STEPS)));
+	program.set_uniform<int>("atlas", 0);
+
+	atlas.bind_colour_texture(0, 0);
+
+	glBindVertexArray(VAO);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<int>(instances.size()));
+	glBindVertexArray(0);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	instances.clear();
+	rotations.clear();
+}
+
+vec3 Impostor::get_view_direction(const UInt& azimuth, const UInt& elevation) {
+	const float azimuth_angle = (2.0f * static_cast<float>(M_PI) * azimuth) / AZIMUTH_STEPS;
+	const float elevation_angle = MIN_ELEVATION + ((MAX_ELEVATION - MIN_ELEVATION) * elevation) / (ELEVATION_STEPS - 1);
+
+	return vec3(std::cos(elevation_angle) * std::sin(azimuth_angle), std::sin(elevation_angle), std::cos(elevation_angle) * std::cos(azimuth_angle));
+}
+
+UInt Impostor::get_closest_cell(const vec3& local_direction) {
+	if (length_squared(local_direction) <= 0.0f) { return 0; }
+	const vec3 direction = normalise(local_direction);
+
+	const float azimuth_step = (2.0f * static_cast<float>(M_PI)) / AZIMUTH_STEPS;
+	const float elevation_step = (MAX_ELEVATION - MIN_ELEVATION) / (ELEVATION_STEPS - 1);
+
+	const int azimuth = static_cast<int>(std::round(std::atan2(direction.x, direction.z) / azimuth_step));
+	const int elevation = static_cast<int>(std::round((std::asin(std::max(-1.0f, std::min(1.0f, direction.y))) - MIN_ELEVATION) / elevation_step));
+
+	const int azimuth_steps = static_cast<int>(AZIMUTH_STEPS);
+	const int wrapped_azimuth = ((azimuth % azimuth_steps) + azimuth_steps) % azimuth_steps;
+	const int clamped_elevation = std::max(0, std::min(elevation, static_cast<int>(ELEVATION_STEPS) - 1));
+
+	return static_cast<UInt>(clamped_elevation * azimuth_steps + wrapped_azimuth);
+}
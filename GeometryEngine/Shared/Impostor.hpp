@@ -0,0 +1,65 @@
+#pragma once
+#include "RenderTarget.hpp"
+#include "Shape.hpp"
+
+
+class Impostor {
+	/*
+	Pre-rendered views of a shape drawn as camera facing quads
+
+	The shape is rendered from AZIMUTH_STEPS x ELEVATION_STEPS directions into one atlas using
+	whichever program is passed to bake (normally the lit program, so lighting is baked in).
+	Instances are queued each frame and drawn with a single instanced draw, each quad sampling
+	the atlas cell closest to the direction it is viewed from.
+
+	Instances carry a 'fade out' value shared with the DITHER_FADE lit variant: the mesh keeps the
+	pixels whose dither threshold is at or above it and the impostor keeps the rest, so the two
+	cross-fade without blending or sorting
+	*/
+
+public:
+	static const UInt AZIMUTH_STEPS = 8;
+	static const UInt ELEVATION_STEPS = 4;
+
+	inline static SHADER_ID GENERIC_ID() { return "Impostor"; }
+
+	Impostor(const UInt& cell_size = 128);
+	~Impostor();
+
+	Impostor(const Impostor& other) = delete;
+	void operator=(const Impostor& other) = delete;
+
+	// Renders every view of the shape, which must be centred on the origin
+	// The program's 'VP' and 'view_position' uniforms are overwritten
+	void bake(Shape& shape, const SHADER_ID& id);
+	inline bool is_baked() const { return baked; }
+
+	void add_instance(const vec3& centre, const quat& rotation, const float& radius, const vec3& tint, const float& fade_out);
+
+	// Draws and then clears every queued instance
+	void render(const mat4& view, const mat4& projection, const vec3& view_position);
+
+private:
+	struct Instance {
+		vec4 centre_radius;
+		vec4 tint_fade_out;
+		float cell;
+	};
+
+	// Elevations are spread from below the horizon to well above it, the camera rarely looks straight down
+	static const float MIN_ELEVATION;
+	static const float MAX_ELEVATION;
+
+	RenderTarget atlas;
+	UInt cell_size;
+	bool baked = false;
+
+	std::vector<Instance> instances;
+	std::vector<quat> rotations;
+
+	UInt VAO = 0;
+	UInt instance_buffer = 0;
+
+	static vec3 get_view_direction(const UInt& azimuth, const UInt& elevation);
+	static UInt get_closest_cell(const vec3& local_direction);
+};
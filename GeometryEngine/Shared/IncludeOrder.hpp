@@ -52,4 +52,6 @@
 #include <random>
 #include <array>
 #include <map>
+#include <set>
+#include <functional>
 #include <cassert>
@@ -0,0 +1,242 @@
+#include "IndirectRenderer.hpp"
+#include "ResourceHandler.hpp"
+
+const UInt IndirectRenderer::CULL_GROUP_SIZE = 64;
+
+
+bool IndirectRenderer::is_supported() {
+	static int supported = -1;
+
+	if (supported < 0) {
+		supported = 0;
+
+#ifdef GL_COMPUTE_SHADER
+		int major = 0;
+		int minor = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+		if ((major > 4) || ((major == 4) && (minor >= 3))) { supported = 1; }
+#endif
+	}
+
+	return supported == 1;
+}
+
+IndirectRenderer::IndirectRenderer(const size_t& initial_capacity) : capacity(0) {
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	glGenBuffers(1, &object_buffer);
+	glGenBuffers(1, &command_buffer);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), nullptr);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, normal));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, texture_coords));
+
+	// The model matrix is a column per attribute, stepped once per instance
+	glBindBuffer(GL_ARRAY_BUFFER, object_buffer);
+	for (UInt column = 0; column < 4; ++column) {
+		glEnableVertexAttribArray(3 + column);
+		glVertexAttribPointer(3 + column, 4, GL_FLOAT, GL_FALSE, sizeof(Object), (void*)(offsetof(Object, model) + (column * sizeof(vec4))));
+		glVertexAttribDivisor(3 + column, 1);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	reserve(std::max(initial_capacity, static_cast<size_t>(1)));
+}
+
+IndirectRenderer::~IndirectRenderer() {
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+	glDeleteBuffers(1, &object_buffer);
+	glDeleteBuffers(1, &command_buffer);
+}
+
+void IndirectRenderer::submit(Model& model) {
+	const std::vector<Geometry>& model_geometries = add_geometry(model);
+	model.update_meshes();
+
+	for (size_t mesh_iter = 0; mesh_iter < model.meshes.size(); ++mesh_iter) {
+		Mesh& mesh = model.meshes.at(mesh_iter);
+		const Geometry& geometry = model_geometries.at(mesh_iter);
+
+		// Levels of detail are still chosen on the CPU, where each mesh remembers its last choice for hysteresis
+		const size_t lod = std::min(mesh.get_current_lod(), geometry.lod_ranges.size() - 1);
+		const std::pair<size_t, size_t>& range = geometry.lod_ranges.at(lod);
+
+		Object object;
+		const mat4 model_matrix = mesh.get_model_matrix();
+		std::copy(value_ptr(model_matrix), value_ptr(model_matrix) + 16, object.model);
+		object.bounds = vec4(mesh.get_bounds_centre(), mesh.get_bounds_radius());
+		object.first_index = static_cast<UInt>(range.first);
+		object.count = static_cast<UInt>(range.second);
+		object.base_vertex = geometry.base_vertex;
+		object.padding = 0;
+
+		int diffuse_texture = mesh.find_texture("texture_diffuse");
+		int specular_texture = mesh.find_texture("texture_specular");
+
+		if (diffuse_texture < 0) {
+			static const UInt debug_texture = Shape::load_texture_from_rgba(Colours::DEBUG_COLOUR);
+			diffuse_texture = static_cast<int>(debug_texture);
+		}
+		if (specular_texture < 0) { specular_texture = diffuse_texture; }
+
+		objects.push_back(object);
+		materials.push_back({ static_cast<UInt>(diffuse_texture), static_cast<UInt>(specular_texture) });
+	}
+}
+
+void IndirectRenderer::render(const SHADER_ID& id, const Frustum& frustum) {
+	if (objects.empty()) { return; }
+
+#ifdef GL_COMPUTE_SHADER
+	LightMapProgram* program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(id));
+	if (!program) { throw std::runtime_error("Indirect draws need a lit program, " + id + " is not one"); }
+
+	if (geometry_changed) { upload_geometry(); }
+
+	// Each material's objects must be contiguous so that its commands are drawn together
+	std::vector<size_t> order(objects.size());
+	for (size_t iter = 0; iter < order.size(); ++iter) { order.at(iter) = iter; }
+
+	std::stable_sort(order.begin(), order.end(), [this](const size_t& a, const size_t& b) {
+		const Material& first = materials.at(a);
+		const Material& second = materials.at(b);
+
+		if (first.diffuse_texture != second.diffuse_texture) { return first.diffuse_texture < second.diffuse_texture; }
+		return first.specular_texture < second.specular_texture;
+	});
+
+	std::vector<Object> sorted_objects;
+	sorted_objects.reserve(objects.size());
+	for (size_t iter = 0; iter < order.size(); ++iter) { sorted_objects.push_back(objects.at(order.at(iter))); }
+
+	reserve(sorted_objects.size());
+	glBindBuffer(GL_ARRAY_BUFFER, object_buffer);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sorted_objects.size() * sizeof(Object), &sorted_objects[0]);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Cull, writing a command per object
+	const UInt object_count = static_cast<UInt>(sorted_objects.size());
+	ComputeProgram& cull = dynamic_cast<ComputeProgram&>(ResourceHandler::get_instance().get_program(CULL_ID()));
+	cull.set_uniform<int>("object_count", static_cast<int>(object_count));
+
+	const std::array<vec4, 6>& planes = frustum.get_planes();
+	for (size_t iter = 0; iter < planes.size(); ++iter) {
+		cull.set_uniform<vec4>("planes[" + std::to_string(iter) + "]", planes.at(iter));
+	}
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, object_buffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, command_buffer);
+	cull.dispatch((object_count + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE);
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+
+	// Draw, one call per material
+	program->set_feature(LightMapFeatures::INDIRECT, true);
+	program->set_uniform<float>("material.shininess", 16.0f);
+	program->set_uniform<int>("material.texture_diffuse", 0);
+	program->set_uniform<int>("material.texture_specular", 1);
+	program->use();
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer);
+
+	size_t group_start = 0;
+	for (size_t iter = 1; iter <= order.size(); ++iter) {
+		const Material& material = materials.at(order.at(group_start));
+
+		if (iter < order.size()) {
+			const Material& next = materials.at(order.at(iter));
+			if ((next.diffuse_texture == material.diffuse_texture) && (next.specular_texture == material.specular_texture)) { continue; }
+		}
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, material.diffuse_texture);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, material.specular_texture);
+
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(group_start * sizeof(DrawCommand)), static_cast<int>(iter - group_start), 0);
+		group_start = iter;
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	program->set_feature(LightMapFeatures::INDIRECT, false);
+#endif
+
+	objects.clear();
+	materials.clear();
+}
+
+const std::vector<IndirectRenderer::Geometry>& IndirectRenderer::add_geometry(Model& model) {
+	std::map<std::string, std::vector<Geometry>>::iterator found = geometries.find(model.get_file_path());
+	if (found != geometries.end()) { return found->second; }
+
+	std::vector<Geometry> model_geometries;
+
+	for (size_t mesh_iter = 0; mesh_iter < model.meshes.size(); ++mesh_iter) {
+		const Mesh& mesh = model.meshes.at(mesh_iter);
+
+		// Indices stay relative to the mesh, the command's base vertex offsets them
+		Geometry geometry;
+		geometry.base_vertex = static_cast<UInt>(vertices.size());
+		vertices.insert(vertices.end(), mesh.get_vertices().begin(), mesh.get_vertices().end());
+
+		std::vector<std::vector<UInt>> lods = { mesh.get_indices() };
+		lods.insert(lods.end(), mesh.get_lods().begin(), mesh.get_lods().end());
+
+		for (size_t lod_iter = 0; lod_iter < lods.size(); ++lod_iter) {
+			const std::vector<UInt>& lod = lods.at(lod_iter);
+			geometry.lod_ranges.push_back(std::make_pair(indices.size(), lod.size()));
+			indices.insert(indices.end(), lod.begin(), lod.end());
+		}
+
+		model_geometries.push_back(geometry);
+	}
+
+	geometry_changed = true;
+	return geometries.insert({ model.get_file_path(), model_geometries }).first->second;
+}
+
+void IndirectRenderer::upload_geometry() {
+	if (vertices.empty() || indices.empty()) { return; }
+
+	// Both are only bound to the array target to upload, so the VAO's element buffer binding is left alone
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex), &vertices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(UInt), &indices[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	geometry_changed = false;
+}
+
+void IndirectRenderer::reserve(const size_t& object_count) {
+	if (object_count <= capacity) { return; }
+	capacity = std::max(object_count, capacity * 2);
+
+	// Reallocating keeps the buffer names, so the VAO's instanced attributes still point at the object buffer
+	glBindBuffer(GL_ARRAY_BUFFER, object_buffer);
+	glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Object), nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, command_buffer);
+	glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(DrawCommand), nullptr, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "Model.hpp"
+#include "Frustum.hpp"
+
+
+class IndirectRenderer {
+	/*
+	Draws many dynamic models with one glMultiDrawElementsIndirect per material
+
+	Every submitted model's meshes are copied once, per model file, into one shared vertex and
+	element buffer. Each frame the submitted objects (their transform, bounds and the index range
+	of the level of detail chosen on the CPU) are uploaded into a buffer that a compute pass reads
+	to frustum cull them, writing one draw command per object. The commands are then drawn without
+	returning to the CPU, grouped by material.
+
+	The lit shaders are GLSL 3.30, which has no shader storage blocks, so the vertex stage does not
+	index the object buffer by gl_BaseInstance itself: the same buffer is bound as a per-instance
+	attribute, which the command's base instance advances to the right object (the INDIRECT lit
+	variant).
+
+	Needs a 4.3 context, check is_supported() and draw each model as normal otherwise
+	*/
+
+public:
+	inline static SHADER_ID CULL_ID() { return "IndirectCull"; }
+
+	// Compute shaders and indirect multi-draws are core in 4.3, the context may be newer than the 3.3 that is requested
+	static bool is_supported();
+
+	IndirectRenderer(const size_t& initial_capacity = 256);
+	~IndirectRenderer();
+
+	IndirectRenderer(const IndirectRenderer& other) = delete;
+	void operator=(const IndirectRenderer& other) = delete;
+
+	// Queues every mesh of the model with its current transform, the model's geometry is copied the first time its file is seen
+	void submit(Model& model);
+
+	// Culls, draws and then clears every submitted object, only the lit program has an INDIRECT variant
+	void render(const SHADER_ID& id, const Frustum& frustum);
+
+	inline size_t get_object_count() const { return objects.size(); }
+
+private:
+	// std430 layouts, must match indirect_cull_compute.shader
+	struct Object {
+		float model[16];
+		vec4 bounds;
+		UInt first_index;
+		UInt count;
+		UInt base_vertex;
+		UInt padding;
+	};
+
+	struct DrawCommand {
+		UInt count;
+		UInt instance_count;
+		UInt first_index;
+		int base_vertex;
+		UInt base_instance;
+	};
+
+	struct Geometry {
+		UInt base_vertex;
+		std::vector<std::pair<size_t, size_t>> lod_ranges;	// First index and count of each level of detail, LOD 0 first
+	};
+
+	struct Material {
+		UInt diffuse_texture;
+		UInt specular_texture;
+	};
+
+	// Must match the compute shader's local size
+	static const UInt CULL_GROUP_SIZE;
+
+	// One entry per mesh of each model file seen
+	std::map<std::string, std::vector<Geometry>> geometries;
+
+	std::vector<MeshVertex> vertices;
+	std::vector<UInt> indices;
+	bool geometry_changed = false;
+
+	std::vector<Object> objects;
+	std::vector<Material> materials;	// Parallel to objects
+
+	size_t capacity;
+
+	UInt VAO = 0;
+	UInt VBO = 0;
+	UInt EBO = 0;
+	UInt object_buffer = 0;
+	UInt command_buffer = 0;
+
+	const std::vector<Geometry>& add_geometry(Model& model);
+	void upload_geometry();
+	void reserve(const size_t& object_count);
+};
@@ -3,16 +3,19 @@
 
 LightMapProgram::LightMapProgram(const std::string& vertex_shader_path,
                                  const std::string& fragment_shader_path,
-                                 const std::string& geometry_shader_path) :
-vertex_path(vertex_shader_path),
-fragment_path(fragment_shader_path),
-geometry_path(geometry_shader_path) {
+                                 const std::string& geometry_shader_path) {
     
+    vertex_source = read_source(vertex_shader_path);
+    fragment_source = read_source(fragment_shader_path);
+    if (geometry_shader_path != std::string()) { geometry_source = read_source(geometry_shader_path); }
+
+    _records_uniforms = true;
 	set_light_count();
 }
 
 LightMapProgram::~LightMapProgram() {
 	reset();
+	delete_variants();
 }
 
 void LightMapProgram::reset() {
@@ -27,58 +30,141 @@ void LightMapProgram::add_light(PointLight* light) {
         std::string light_index = std::to_string(iter);
         PointLight* light = lights.at(iter);
         
-        set_uniform<vec3>("lights[" + light_index + "].position", light->position);
-        set_uniform<vec3>("lights[" + light_index + "].light_colour", light->light_colour);
+        set_persistent_uniform<vec3>("lights[" + light_index + "].position", light->position);
+        set_persistent_uniform<vec3>("lights[" + light_index + "].light_colour", light->light_colour);
         
-        set_uniform<float>("lights[" + light_index + "].constant_val", light->constant_val);
-        set_uniform<float>("lights[" + light_index + "].linear_val", light->linear_val);
-        set_uniform<float>("lights[" + light_index + "].quadratic", light->quadratic);
+        set_persistent_uniform<float>("lights[" + light_index + "].constant_val", light->constant_val);
+        set_persistent_uniform<float>("lights[" + light_index + "].linear_val", light->linear_val);
+        set_persistent_uniform<float>("lights[" + light_index + "].quadratic", light->quadratic);
         
-        set_uniform<vec3>("lights[" + light_index + "].ambient", light->ambient);
-        set_uniform<vec3>("lights[" + light_index + "].diffuse", light->diffuse);
-        set_uniform<vec3>("lights[" + light_index + "].specular", light->specular);
+        set_persistent_uniform<vec3>("lights[" + light_index + "].ambient", light->ambient);
+        set_persistent_uniform<vec3>("lights[" + light_index + "].diffuse", light->diffuse);
+        set_persistent_uniform<vec3>("lights[" + light_index + "].specular", light->specular);
     }
 }
 
 void LightMapProgram::set_light_position(const UInt& light_index, const vec3& new_pos) {
-	set_uniform<vec3>("lights[" + std::to_string(light_index) + "].position", new_pos);
+	set_persistent_uniform<vec3>("lights[" + std::to_string(light_index) + "].position", new_pos);
 	lights.at(light_index)->position = new_pos;
 }
 
 void LightMapProgram::set_light_colour(const UInt& light_index, const vec3& colour){
-    set_uniform<vec3>("lights[" + std::to_string(light_index) + "].light_colour", colour);
+    set_persistent_uniform<vec3>("lights[" + std::to_string(light_index) + "].light_colour", colour);
     lights.at(light_index)->light_colour = colour;
 }
 
 void LightMapProgram::set_light_count(){
-    glDeleteProgram(_program_id);
-        
-    if (!boost::filesystem::exists(vertex_path)) { throw std::runtime_error(vertex_path + " does not exist"); }
-    else if (!boost::filesystem::exists(fragment_path)) { throw std::runtime_error(fragment_path + " does not exist"); }
-    
-    std::ifstream vertex_file_stream(vertex_path);
-    const std::string vertex_file_string((std::istreambuf_iterator<char>(vertex_file_stream)), std::istreambuf_iterator<char>());
-    
-    std::ifstream fragment_file_stream(fragment_path);
-    const std::string fragment_file_string((std::istreambuf_iterator<char>(fragment_file_stream)), std::istreambuf_iterator<char>());
-    std::string modified_fragment_string;
-    
-    std::string geometry_file_string;
-    if (geometry_path != std::string()){
-        std::ifstream geometry_file_stream(geometry_path);
-        geometry_file_string = std::string((std::istreambuf_iterator<char>(geometry_file_stream)), std::istreambuf_iterator<char>());
-    }
-    
-    for (size_t index = 0; index < fragment_file_string.size(); index++){
-        const char current_char = fragment_file_string.at(index);
-        modified_fragment_string.append(current_char == '$' ? std::to_string(get_light_count()) : std::string(1, current_char));
-    }
-    
-    const UInt vertex_id = _compile_shader_string(GL_VERTEX_SHADER, vertex_file_string);
-    const UInt fragment_id = _compile_shader_string(GL_FRAGMENT_SHADER, modified_fragment_string);
+    delete_variants();
+    select_variant();
+}
+
+void LightMapProgram::set_feature(const UInt& feature, const bool enabled) {
+	const UInt new_features = enabled ? (features | feature) : (features & ~feature);
+	if (new_features == features) { return; }
+
+	features = new_features;
+	select_variant();
+}
+
+void LightMapProgram::set_quality_tier(const UInt& tier) {
+	if (tier == quality_tier) { return; }
+
+	quality_tier = std::min(tier, LightMapFeatures::HIGH_QUALITY);
+	select_variant();
+}
+
+void LightMapProgram::_record_uniform(const std::string& uniform_name, const std::function<void(const UInt&)>& apply) {
+	recorded_uniforms[uniform_name] = { apply, ++uniform_serial };
+
+	// The value was just set on the current variant, so it is already up to date
+	std::map<UInt, Variant>::iterator current = variants.find(get_variant_key());
+	if (current != variants.end()) { current->second.synced_serial = uniform_serial; }
+}
+
+void LightMapProgram::select_variant() {
+	const UInt key = get_variant_key();
+
+	std::map<UInt, Variant>::iterator found = variants.find(key);
+	if (found == variants.end()) {
+		found = variants.insert({ key, { compile_variant(key), 0 } }).first;
+	}
+
+	Variant& variant = found->second;
+	_program_id = variant.program_id;
 
-    if (geometry_path != std::string()){
-        UInt geometry_id = _compile_shader_string(GL_GEOMETRY_SHADER, geometry_file_string);
+	// Replay only what has changed since this variant was last used
+	if (variant.synced_serial < uniform_serial) {
+		for (std::map<std::string, RecordedUniform>::iterator iter = recorded_uniforms.begin(); iter != recorded_uniforms.end(); ++iter) {
+			if (iter->second.serial > variant.synced_serial) { iter->second.apply(_program_id); }
+		}
+
+		variant.synced_serial = uniform_serial;
+	}
+}
+
+UInt LightMapProgram::compile_variant(const UInt& key) {
+	const bool explode = ((key & LightMapFeatures::GEOMETRY_EXPLODE) != 0) && (geometry_source != std::string());
+
+	std::string defines = "#define LIGHT_COUNT " + std::to_string(get_light_count()) + "\n";
+	defines += "#define QUALITY_TIER " + std::to_string(key >> 8) + "\n";
+	if (key & LightMapFeatures::SHADOWS) { defines += "#define SHADOWS\n"; }
+	if (key & LightMapFeatures::LIGHT_COLOUR) { defines += "#define LIGHT_COLOUR\n"; }
+	if (explode) { defines += "#define GEOMETRY_EXPLODE\n"; }
+	if (key & LightMapFeatures::DITHER_FADE) { defines += "#define DITHER_FADE\n"; }
+	if (key & LightMapFeatures::INDIRECT) { defines += "#define INDIRECT\n"; }
+
+    const UInt vertex_id = _compile_shader_string(GL_VERTEX_SHADER, inject_defines(vertex_source, defines));
+    const UInt fragment_id = _compile_shader_string(GL_FRAGMENT_SHADER, inject_defines(fragment_source, defines));
+
+    // Only the exploding variant pays for a geometry stage
+    if (explode){
+        const UInt geometry_id = _compile_shader_string(GL_GEOMETRY_SHADER, inject_defines(geometry_source, defines));
         _link_program_id(vertex_id, fragment_id, geometry_id);
+        glDeleteShader(geometry_id);
     } else { _link_program_id(vertex_id, fragment_id); }
+
+    glDeleteShader(vertex_id);
+    glDeleteShader(fragment_id);
+
+    return _program_id;
+}
+
+void LightMapProgram::delete_variants() {
+	for (std::map<UInt, Variant>::iterator iter = variants.begin(); iter != variants.end(); ++iter) {
+		glDeleteProgram(iter->second.program_id);
+	}
+
+	variants.clear();
+	_program_id = 0;
+}
+
+std::string LightMapProgram::read_source(const std::string& path) {
+    if (!boost::filesystem::exists(path)) { throw std::runtime_error(path + " does not exist"); }
+
+    std::ifstream file_stream(path);
+    std::string source((std::istreambuf_iterator<char>(file_stream)), std::istreambuf_iterator<char>());
+
+	// Each '#include "file"' line is replaced by that file, found next to this one
+	const std::string directive = "#include \"";
+	for (size_t include_position = source.find(directive); include_position != std::string::npos; include_position = source.find(directive, include_position)) {
+		const size_t name_start = include_position + directive.size();
+		const size_t name_end = source.find('"', name_start);
+		if (name_end == std::string::npos) { throw std::runtime_error(path + " has an unterminated #include"); }
+
+		const boost::filesystem::path included = boost::filesystem::path(path).parent_path() / source.substr(name_start, name_end - name_start);
+		source.replace(include_position, (name_end + 1) - include_position, read_source(included.string()));
+	}
+
+	return source;
+}
+
+std::string LightMapProgram::inject_defines(const std::string& source, const std::string& defines) {
+	// '#version' must remain the first statement
+	const size_t version_position = source.find("#version");
+	if (version_position == std::string::npos) { return defines + source; }
+
+	const size_t line_end = source.find('\n', version_position);
+	if (line_end == std::string::npos) { return source + "\n" + defines; }
+
+	return source.substr(0, line_end + 1) + defines + source.substr(line_end + 1);
 }
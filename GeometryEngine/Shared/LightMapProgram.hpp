@@ -15,19 +15,40 @@ struct PointLight {
 	vec3 specular;
 };
 
+namespace LightMapFeatures {
+	// Each feature is compiled in as a #define rather than branched on with a uniform
+	static const UInt GEOMETRY_EXPLODE = 1 << 0;	// Attaches the geometry stage
+	static const UInt SHADOWS = 1 << 1;
+	static const UInt LIGHT_COLOUR = 1 << 2;
+	static const UInt DITHER_FADE = 1 << 3;			// Screen-door fade against an impostor, driven by 'fade_out'
+	static const UInt INDIRECT = 1 << 4;			// 'model' comes from a per-instance attribute, see IndirectRenderer
+
+	// Quality tiers select how many shadow filtering taps are taken
+	static const UInt LOW_QUALITY = 0;
+	static const UInt MEDIUM_QUALITY = 1;
+	static const UInt HIGH_QUALITY = 2;
+
+	// Taps taken by each tier, these must match SAMPLE_SIZE in the fragment shader
+	static inline UInt get_shadow_taps(const UInt& tier) { return (tier == LOW_QUALITY) ? 4 : ((tier == MEDIUM_QUALITY) ? 8 : 20); }
+}
+
 class LightMapProgram : public Program {
     // Very specialised type of program, needs to dynamically adapt to current scene contexts
 	// THIS PROGRAM MUST ALSO INCLUDE SHADOWS
     
     /*
-	Class able to parse:
-	
-	...
-	uniform LightPoint[$] light_points
-	...
-	
-	This class will substitute the '#' for the number of lights
-	Requirements: A LightPoint struct in the shader
+	Builds program variants from feature sets
+
+	Each variant is compiled with the following injected after '#version':
+		#define LIGHT_COUNT [number of lights]
+		#define QUALITY_TIER [tier]
+		#define SHADOWS / LIGHT_COLOUR / GEOMETRY_EXPLODE / DITHER_FADE / INDIRECT (when enabled)
+
+	Variants are compiled the first time they are needed and cached. Uniforms set with
+	set_persistent_uniform are recorded so that switching variant replays any values the new
+	variant has not yet received, per-draw uniforms must be set after the switch
+	Sources may '#include "file"' another shader next to them, such as shadow_filter.shader
+	Requirements, when lights are added: A PointLight struct in the shader, 'uniform PointLight lights[LIGHT_COUNT]'
 	*/
 
 public:
@@ -45,14 +66,48 @@ public:
 	void set_light_position(const UInt& light_index, const vec3& new_pos);
     void set_light_colour(const UInt& light_index, const vec3& colour);
 
+	// Any change in light count invalidates every variant
 	void set_light_count();
 	void reset();
+
+	void set_feature(const UInt& feature, const bool enabled);
+	inline bool has_feature(const UInt& feature) const { return (features & feature) != 0; }
+
+	void set_quality_tier(const UInt& tier);
+	inline UInt get_quality_tier() const { return quality_tier; }
+
+protected:
+	virtual void _record_uniform(const std::string& uniform_name, const std::function<void(const UInt&)>& apply);
     
 private:
+	struct Variant {
+		UInt program_id;
+		size_t synced_serial;	// Last recorded uniform this variant has received
+	};
+
+	struct RecordedUniform {
+		std::function<void(const UInt&)> apply;
+		size_t serial;
+	};
+
 	std::vector<PointLight*> lights;
     
-    std::string vertex_path;
-    std::string fragment_path;
-    std::string geometry_path;
-};
+    std::string vertex_source;
+    std::string fragment_source;
+    std::string geometry_source;
+
+	UInt features = LightMapFeatures::SHADOWS | LightMapFeatures::LIGHT_COLOUR;
+	UInt quality_tier = LightMapFeatures::HIGH_QUALITY;
 
+	std::map<UInt, Variant> variants;
+	std::map<std::string, RecordedUniform> recorded_uniforms;
+	size_t uniform_serial = 0;
+
+	void select_variant();
+	UInt compile_variant(const UInt& key);
+	void delete_variants();
+
+	inline UInt get_variant_key() const { return features | (quality_tier << 8); }
+	static std::string read_source(const std::string& path);
+	static std::string inject_defines(const std::string& source, const std::string& defines);
+};
@@ -183,6 +183,14 @@ Matrix4x4<T> ortho(const T& left, const T& right, const T& bottom, const T& top)
 	return result;
 }
 
+template <typename T>
+Matrix4x4<T> ortho(const T& left, const T& right, const T& bottom, const T& top, const T& near_plane, const T& far_plane) {
+	Matrix4x4<T> result = ortho(left, right, bottom, top);
+	result[2][2] = -static_cast<T>(2) / (far_plane - near_plane);
+	result[3][2] = -(far_plane + near_plane) / (far_plane - near_plane);
+	return result;
+}
+
 template <typename T>
 Matrix4x4<T> perspective(const T& fov, const T& aspect_ratio, const T& near_plane, const T& far_plane) {
 	const T theta = std::tan(fov / static_cast<T>(2));
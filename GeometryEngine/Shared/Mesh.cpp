@@ -1,9 +1,19 @@
 #include "Mesh.hpp"
 #include "ResourceHandler.hpp"
+#include "DeferredRenderer.hpp"
 
+const std::vector<float> Mesh::LOD_SCREEN_RADII = { 180.0f, 70.0f, 25.0f };
+const float Mesh::LOD_HYSTERESIS = 0.15f;
+
+const float Mesh::HALF_TEXTURE_COORD_LIMIT = 2.0f;
+const float Mesh::MAX_QUANTISATION_ERROR = 0.0005f;
+
+static_assert(sizeof(MeshVertex) == 8 * sizeof(float), "MeshVertex must match VertexFormats::STANDARD");
 
 Mesh::Mesh(const std::vector<MeshVertex>& mesh_vertices, const std::vector<UInt>& indices, const std::vector<MeshTexture>& textures) :
-    Shape(), mesh_vertices(mesh_vertices), indices(indices), textures(textures) {}
+    Shape(), mesh_vertices(mesh_vertices), indices(indices), textures(textures) {
+	compute_bounds();
+}
 
 void Mesh::render(const SHADER_ID& id){
 	SHADER_ID correct_id = id == SHADER_ID() ? GENERIC_ID() : id;
@@ -11,9 +21,14 @@ void Mesh::render(const SHADER_ID& id){
     Program& program = ResourceHandler::get_instance().get_program(correct_id);
     evaluate_changed();
 
-    program.set_uniform<mat4>("model", get_model_matrix());
+	// Quantised positions are brought back into model space along with the rest of the transform
+	const mat4 model_matrix = get_model_matrix();
+	program.set_uniform<mat4>("model", (vertex_format == VertexFormats::QUANTISED) ? (model_matrix * dequantisation) : model_matrix);
 
-	if (correct_id == GENERIC_ID()) {
+	// Only programs that shade the surface need the material textures
+	const bool uses_material = (correct_id == GENERIC_ID()) || (correct_id == DeferredRenderer::GEOMETRY_ID());
+
+	if (uses_material) {
 		// Bind appropriate textures
 		for (size_t i = 0; i < textures.size(); ++i) {
 			// Active proper texture unit before binding
@@ -26,20 +41,28 @@ void Mesh::render(const SHADER_ID& id){
 		program.set_uniform<float>("material.shininess", 16.0f);
 	}
 
+	const bool blending_enabled = uses_material && enable_blending();
+
     // Draw mesh
-    glBindVertexArray(_VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<int>(indices.size()), GL_UNSIGNED_INT, 0);
+    BufferAllocator::get_instance().bind(_buffer_range.format);
+	const std::pair<size_t, size_t>& range = lod_ranges.at(current_lod);
+	const size_t index_size = (index_type == GL_UNSIGNED_SHORT) ? sizeof(UShort) : sizeof(UInt);
+    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<int>(range.second), index_type,
+							 (void*)(_buffer_range.index_offset + (range.first * index_size)), static_cast<int>(_buffer_range.first_vertex));
     glBindVertexArray(0);
     
-	if (correct_id == GENERIC_ID()) {
+	if (uses_material) {
 		for (size_t i = 0; i < textures.size(); ++i) {
 			glActiveTexture(GL_TEXTURE0 + static_cast<unsigned int>(i));
 			glBindTexture(GL_TEXTURE_2D, 0);
 		}
 	}
+
+	if (blending_enabled) { glDisable(GL_BLEND); }
 }
 
-Mesh::Mesh(const Mesh& other) : Shape(), mesh_vertices(other.mesh_vertices), indices(other.indices), textures(other.textures) {
+Mesh::Mesh(const Mesh& other) : Shape(), mesh_vertices(other.mesh_vertices), indices(other.indices), textures(other.textures),
+	lod_indices(other.lod_indices), current_lod(other.current_lod), bounds_centre(other.bounds_centre), bounds_radius(other.bounds_radius) {
 	quaternion = other.quaternion;
 	rotation_point = other.rotation_point;
     translation_vector = other.translation_vector;
@@ -53,6 +76,10 @@ void Mesh::operator=(const Mesh& other){
     this->mesh_vertices = other.mesh_vertices;
     this->indices = other.indices;
     this->textures = other.textures;
+	this->lod_indices = other.lod_indices;
+	this->current_lod = other.current_lod;
+	this->bounds_centre = other.bounds_centre;
+	this->bounds_radius = other.bounds_radius;
     
 	quaternion = other.quaternion;
 	rotation_point = other.rotation_point;
@@ -67,32 +94,212 @@ void Mesh::evaluate_changed(){
     if (!_needs_evaluation) { return; }
     _needs_evaluation = false;
     
-    glDeleteVertexArrays(1, &_VAO);
-    glDeleteBuffers(1, &_VBO);
-	glDeleteBuffers(1, &EBO);
-    
-    glGenVertexArrays(1, &_VAO);
-    glBindVertexArray(_VAO);
-    
-    glGenBuffers(1, &_VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-    glBufferData(GL_ARRAY_BUFFER, mesh_vertices.size() * sizeof(MeshVertex), &mesh_vertices[0], GL_STATIC_DRAW);
-    
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(UInt), &indices[0], GL_STATIC_DRAW);
-    
-    // Vertices
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), nullptr);
-    
-    // Vertex Normals
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, normal));
-    
-    // Vertex Textures
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, texture_coords));
-    
-    glBindVertexArray(0);
+	// Every level of detail lives back to back in one index range over the shared vertices
+	std::vector<UInt> all_indices = indices;
+	lod_ranges = { std::make_pair(static_cast<size_t>(0), indices.size()) };
+
+	for (size_t i = 0; i < lod_indices.size(); ++i) {
+		lod_ranges.push_back(std::make_pair(all_indices.size(), lod_indices.at(i).size()));
+		all_indices.insert(all_indices.end(), lod_indices.at(i).begin(), lod_indices.at(i).end());
+	}
+
+	current_lod = std::min(current_lod, lod_ranges.size() - 1);
+
+	BufferAllocator::get_instance().free(_buffer_range);
+	if (mesh_vertices.empty() || all_indices.empty()) { return; }
+
+	upload(all_indices);
+}
+
+void Mesh::upload(const std::vector<UInt>& all_indices) {
+	BufferAllocator& allocator = BufferAllocator::get_instance();
+
+	vec3 aabb_min;
+	vec3 aabb_max;
+	vertex_format = choose_vertex_format(aabb_min, aabb_max);
+	dequantisation = mat4(1.0f);
+
+	// Indices are relative to the mesh's base vertex, so any mesh under 65536 vertices can use 16 bits
+	index_type = (mesh_vertices.size() <= 65536) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	std::vector<UShort> short_indices;
+	if (index_type == GL_UNSIGNED_SHORT) { short_indices.assign(all_indices.begin(), all_indices.end()); }
+
+	const void* index_data = (index_type == GL_UNSIGNED_SHORT) ? static_cast<const void*>(&short_indices[0]) : static_cast<const void*>(&all_indices[0]);
+	const size_t index_size = all_indices.size() * ((index_type == GL_UNSIGNED_SHORT) ? sizeof(UShort) : sizeof(UInt));
+
+	switch (vertex_format) {
+		case (VertexFormats::COMPACT) : {
+			std::vector<CompactVertex> compact_vertices(mesh_vertices.size());
+
+			for (size_t i = 0; i < mesh_vertices.size(); ++i) {
+				const MeshVertex& vertex = mesh_vertices.at(i);
+				CompactVertex& compact = compact_vertices.at(i);
+
+				compact.position[0] = vertex.position.x;
+				compact.position[1] = vertex.position.y;
+				compact.position[2] = vertex.position.z;
+				compact.normal = encode_normal(vertex.normal);
+				compact.texture_coords[0] = encode_half(vertex.texture_coords.x);
+				compact.texture_coords[1] = encode_half(vertex.texture_coords.y);
+			}
+
+			_buffer_range = allocator.allocate(vertex_format, &compact_vertices[0], compact_vertices.size(), index_data, index_size);
+			break;
+		}
+
+		case (VertexFormats::QUANTISED) : {
+			// One scale for every axis, so the dequantisation never skews the normals
+			const vec3 centre = (aabb_min + aabb_max) * 0.5f;
+			const vec3 half_extent = (aabb_max - aabb_min) * 0.5f;
+			const float step = std::max(std::max(half_extent.x, half_extent.y), std::max(half_extent.z, std::numeric_limits<float>::epsilon())) / 32767.0f;
+
+			std::vector<QuantisedVertex> quantised_vertices(mesh_vertices.size());
+
+			for (size_t i = 0; i < mesh_vertices.size(); ++i) {
+				const MeshVertex& vertex = mesh_vertices.at(i);
+				QuantisedVertex& quantised = quantised_vertices.at(i);
+
+				const vec3 offset = (vertex.position - centre) / step;
+				quantised.position[0] = static_cast<short>(std::round(offset.x));
+				quantised.position[1] = static_cast<short>(std::round(offset.y));
+				quantised.position[2] = static_cast<short>(std::round(offset.z));
+				quantised.position[3] = 0;
+				quantised.normal = encode_normal(vertex.normal);
+				quantised.texture_coords[0] = encode_half(vertex.texture_coords.x);
+				quantised.texture_coords[1] = encode_half(vertex.texture_coords.y);
+			}
+
+			dequantisation = mat4(step);
+			dequantisation[3] = vec4(centre, 1.0f);
+
+			_buffer_range = allocator.allocate(vertex_format, &quantised_vertices[0], quantised_vertices.size(), index_data, index_size);
+			break;
+		}
+
+		default: {
+			_buffer_range = allocator.allocate(VertexFormats::STANDARD, &mesh_vertices[0], mesh_vertices.size(), index_data, index_size);
+			break;
+		}
+	}
+}
+
+UInt Mesh::choose_vertex_format(vec3& aabb_min, vec3& aabb_max) const {
+	aabb_min = mesh_vertices.front().position;
+	aabb_max = mesh_vertices.front().position;
+	float largest_texture_coord = 0.0f;
+
+	for (size_t i = 0; i < mesh_vertices.size(); ++i) {
+		const MeshVertex& vertex = mesh_vertices.at(i);
+
+		aabb_min = vec3(std::min(aabb_min.x, vertex.position.x), std::min(aabb_min.y, vertex.position.y), std::min(aabb_min.z, vertex.position.z));
+		aabb_max = vec3(std::max(aabb_max.x, vertex.position.x), std::max(aabb_max.y, vertex.position.y), std::max(aabb_max.z, vertex.position.z));
+		largest_texture_coord = std::max(largest_texture_coord, std::max(std::abs(vertex.texture_coords.x), std::abs(vertex.texture_coords.y)));
+	}
+
+	if (largest_texture_coord > HALF_TEXTURE_COORD_LIMIT) { return VertexFormats::STANDARD; }
+
+	// Rounding to the nearest step is off by at most half of one
+	const vec3 half_extent = (aabb_max - aabb_min) * 0.5f;
+	const float largest_half_extent = std::max(half_extent.x, std::max(half_extent.y, half_extent.z));
+	if (((largest_half_extent / 32767.0f) * 0.5f) <= MAX_QUANTISATION_ERROR) { return VertexFormats::QUANTISED; }
+
+	return VertexFormats::COMPACT;
+}
+
+UInt Mesh::encode_normal(const vec3& normal) {
+	// Signed normalised 10 bits per axis, x in the lowest bits, w is unused
+	const float components[3] = { normal.x, normal.y, normal.z };
+	UInt packed = 0;
+
+	for (UInt axis = 0; axis < 3; ++axis) {
+		const int value = static_cast<int>(std::round(std::max(-1.0f, std::min(1.0f, components[axis])) * 511.0f));
+		packed |= (static_cast<UInt>(value) & 0x3FF) << (axis * 10);
+	}
+
+	return packed;
+}
+
+UShort Mesh::encode_half(const float& value) {
+	UInt bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const UShort sign = static_cast<UShort>((bits >> 16) & 0x8000);
+	int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+	UInt mantissa = bits & 0x7FFFFF;
+
+	// Too small for a normal half, texture coordinates don't need the subnormals
+	if (exponent <= 0) { return sign; }
+
+	// Round to nearest, which can carry into the exponent
+	mantissa += 0x1000;
+	if (mantissa & 0x800000) {
+		mantissa = 0;
+		exponent++;
+	}
+
+	// Clamped to the largest finite half
+	if (exponent >= 31) { return static_cast<UShort>(sign | 0x7BFF); }
+
+	return static_cast<UShort>(sign | (exponent << 10) | (mantissa >> 13));
+}
+
+void Mesh::update_lod(const vec3& view_position, const float& projection_scale) {
+	if (lod_indices.empty()) { return; }
+
+	vec4 local_centre(bounds_centre, 1.0f);
+	const vec3 centre = to_vec3(get_model_matrix() * local_centre);
+	const vec3 scale = get_enlargement();
+	const float radius = bounds_radius * std::max(scale.x, std::max(scale.y, scale.z));
+	const float view_distance = distance(view_position, centre);
+
+	// Inside the bounds, always use full detail
+	if (view_distance <= radius) {
+		current_lod = 0;
+		return;
+	}
+
+	current_lod = select_lod(current_lod, lod_indices.size(), (radius * projection_scale) / view_distance);
+}
+
+int Mesh::find_texture(const std::string& type) const {
+	for (size_t iter = 0; iter < textures.size(); ++iter) {
+		if (textures.at(iter).type == type) { return textures.at(iter).id; }
+	}
+
+	return -1;
+}
+
+bool Mesh::is_transparent() {
+	const int diffuse_texture = find_texture("texture_diffuse");
+	return (diffuse_texture >= 0) && ResourceHandler::get_instance().is_translucent(static_cast<UInt>(diffuse_texture));
+}
+
+size_t Mesh::select_lod(const size_t& current, const size_t& coarsest, const float& projected_radius) {
+	const size_t coarsest_lod = std::min(coarsest, LOD_SCREEN_RADII.size());
+	size_t lod = std::min(current, coarsest_lod);
+
+	while ((lod < coarsest_lod) && (projected_radius < LOD_SCREEN_RADII.at(lod) * (1.0f - LOD_HYSTERESIS))) { lod++; }
+	while ((lod > 0) && (projected_radius > LOD_SCREEN_RADII.at(lod - 1) * (1.0f + LOD_HYSTERESIS))) { lod--; }
+
+	return lod;
+}
+
+void Mesh::compute_bounds() {
+	if (mesh_vertices.empty()) { return; }
+
+	vec3 minimum = mesh_vertices.front().position;
+	vec3 maximum = mesh_vertices.front().position;
+
+	for (size_t i = 1; i < mesh_vertices.size(); ++i) {
+		const vec3& position = mesh_vertices.at(i).position;
+		minimum = vec3(std::min(minimum.x, position.x), std::min(minimum.y, position.y), std::min(minimum.z, position.z));
+		maximum = vec3(std::max(maximum.x, position.x), std::max(maximum.y, position.y), std::max(maximum.z, position.z));
+	}
+
+	bounds_centre = (minimum + maximum) * 0.5f;
+	bounds_radius = 0.0f;
+
+	for (size_t i = 0; i < mesh_vertices.size(); ++i) {
+		bounds_radius = std::max(bounds_radius, distance(bounds_centre, mesh_vertices.at(i).position));
+	}
 }
@@ -32,19 +32,79 @@ public:
     
     virtual void render(const SHADER_ID& id = Mesh::GENERIC_ID());
     virtual void evaluate_changed();
+
+	// Only the diffuse texture's alpha is used for coverage
+	virtual bool is_transparent();
     
     inline MeshVertex get_vertex(const size_t& index) const { return mesh_vertices.at(index); }
     inline size_t get_vertices_size() const { return mesh_vertices.size(); }
+
+	inline const std::vector<MeshVertex>& get_vertices() const	{ return mesh_vertices; }
+	inline const std::vector<UInt>& get_indices() const			{ return indices; }
+	inline const std::vector<MeshTexture>& get_textures() const	{ return textures; }
+
+	// Texture id of the first texture of the given type ('texture_diffuse' etc.), -1 if the mesh has none
+	int find_texture(const std::string& type) const;
+
+	// Local space bounding sphere
+	inline vec3 get_bounds_centre() const { return bounds_centre; }
+	inline float get_bounds_radius() const { return bounds_radius; }
     
-    inline void set_vertices(const std::vector<MeshVertex>& new_vertices)	{ mesh_vertices = new_vertices; _needs_evaluation = true; }
-    inline void set_indices(const std::vector<UInt>& new_indices)			{ indices = new_indices; _needs_evaluation = true; }
+    inline void set_vertices(const std::vector<MeshVertex>& new_vertices)	{ mesh_vertices = new_vertices; compute_bounds(); lod_indices.clear(); _needs_evaluation = true; }
+    inline void set_indices(const std::vector<UInt>& new_indices)			{ indices = new_indices; lod_indices.clear(); _needs_evaluation = true; }
     inline void set_textures(const std::vector<MeshTexture>& new_textures)	{ textures = new_textures; _needs_evaluation = true; }
+
+	// Levels of detail are index lists into the same vertices, coarsest last (LOD 0 is always the full index list)
+	inline void set_lods(const std::vector<std::vector<UInt>>& new_lods)	{ lod_indices = new_lods; current_lod = 0; _needs_evaluation = true; }
+	inline size_t get_lod_count() const { return lod_indices.size() + 1; }
+	inline size_t get_current_lod() const { return current_lod; }
+	inline const std::vector<std::vector<UInt>>& get_lods() const { return lod_indices; }
+
+	// Picks the level of detail from the projected screen radius of the mesh's bounding sphere
+	// projection_scale is the viewport height divided by 2 * tan(fov / 2)
+	void update_lod(const vec3& view_position, const float& projection_scale);
+
+	// Steps from the current level of detail towards the one suited to the projected radius (in pixels)
+	static size_t select_lod(const size_t& current, const size_t& coarsest, const float& projected_radius);
+
+	// Projected radius (in pixels) below which LOD n + 1 is used
+	static const std::vector<float> LOD_SCREEN_RADII;
+
+	// Fraction of a threshold a mesh must pass beyond it before switching, so it doesn't flicker on the boundary
+	static const float LOD_HYSTERESIS;
+
+	// Chosen per mesh when it is uploaded, see choose_vertex_format()
+	inline UInt get_vertex_format() const { return vertex_format; }
+	inline bool has_short_indices() const { return index_type == GL_UNSIGNED_SHORT; }
+
+	// Half floats lose too much precision past this for texture coordinates, meshes that tile further stay STANDARD
+	static const float HALF_TEXTURE_COORD_LIMIT;
+
+	// Largest error quantised positions may have, in model units, larger meshes keep float positions
+	static const float MAX_QUANTISATION_ERROR;
     
 private:
     std::vector<MeshVertex> mesh_vertices;
     std::vector<UInt> indices;
     std::vector<MeshTexture> textures;
-    
-    UInt EBO;
+
+	std::vector<std::vector<UInt>> lod_indices;
+	std::vector<std::pair<size_t, size_t>> lod_ranges;	// Offset and count within the element buffer of each LOD
+	size_t current_lod = 0;
+
+	vec3 bounds_centre;
+	float bounds_radius = 0.0f;
+
+	UInt vertex_format = VertexFormats::STANDARD;
+	UInt index_type = GL_UNSIGNED_INT;
+	mat4 dequantisation = mat4(1.0f);	// Maps QUANTISED positions back into model space
+
+	void compute_bounds();
+
+	UInt choose_vertex_format(vec3& aabb_min, vec3& aabb_max) const;
+	void upload(const std::vector<UInt>& all_indices);
+
+	static UInt encode_normal(const vec3& normal);
+	static UShort encode_half(const float& value);
 };
 
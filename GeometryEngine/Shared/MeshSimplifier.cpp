@@ -0,0 +1,250 @@
+#include "MeshSimplifier.hpp"
+
+#include <queue>
+
+const double MeshSimplifier::BOUNDARY_WEIGHT = 1000.0;
+const float MeshSimplifier::MIN_FACE_ALIGNMENT = 0.2f;
+
+MeshSimplifier::Quadric::Quadric(const double& a, const double& b, const double& c, const double& d, const double& weight) {
+	this->a[0] = a * a * weight; this->a[1] = a * b * weight; this->a[2] = a * c * weight; this->a[3] = a * d * weight;
+	this->a[4] = b * b * weight; this->a[5] = b * c * weight; this->a[6] = b * d * weight;
+	this->a[7] = c * c * weight; this->a[8] = c * d * weight;
+	this->a[9] = d * d * weight;
+}
+
+MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& other) {
+	for (size_t i = 0; i < 10; ++i) { a[i] += other.a[i]; }
+	return *this;
+}
+
+double MeshSimplifier::Quadric::evaluate(const vec3& point) const {
+	const double x = point.x, y = point.y, z = point.z;
+
+	return	a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x +
+			a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y +
+			a[7] * z * z + 2.0 * a[8] * z +
+			a[9];
+}
+
+std::vector<UInt> MeshSimplifier::simplify(const std::vector<MeshVertex>& vertices, const std::vector<UInt>& indices, const float& target_ratio) {
+	const size_t triangle_count = indices.size() / 3;
+	if ((target_ratio >= 1.0f) || (triangle_count < 4)) { return indices; }
+
+	const size_t target_triangles = std::max(static_cast<size_t>(1), static_cast<size_t>(triangle_count * target_ratio));
+
+	// Vertices sharing a position (UV or normal seams) are simplified as one, otherwise the seams would tear apart
+	std::map<std::array<float, 3>, UInt> position_lookup;
+	std::vector<UInt> vertex_group(vertices.size());
+	std::vector<vec3> positions;
+	std::vector<std::vector<UInt>> group_members;
+
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const vec3& position = vertices.at(i).position;
+		const std::array<float, 3> key = { position.x, position.y, position.z };
+
+		std::map<std::array<float, 3>, UInt>::iterator found = position_lookup.find(key);
+		if (found == position_lookup.end()) {
+			found = position_lookup.insert(std::make_pair(key, static_cast<UInt>(positions.size()))).first;
+			positions.push_back(position);
+			group_members.push_back({});
+		}
+
+		vertex_group.at(i) = found->second;
+		group_members.at(found->second).push_back(static_cast<UInt>(i));
+	}
+
+	struct Triangle {
+		UInt corners[3];	// Original vertex indices
+		UInt groups[3];		// Current (possibly collapsed) position groups
+		bool removed;
+	};
+
+	std::vector<Triangle> triangles;
+	std::vector<std::vector<UInt>> adjacency(positions.size());
+	std::vector<Quadric> quadrics(positions.size());
+	std::map<std::pair<UInt, UInt>, std::vector<UInt>> edge_faces;
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		Triangle triangle;
+		triangle.removed = false;
+
+		for (size_t corner = 0; corner < 3; ++corner) {
+			triangle.corners[corner] = indices.at(i + corner);
+			triangle.groups[corner] = vertex_group.at(indices.at(i + corner));
+		}
+
+		if ((triangle.groups[0] == triangle.groups[1]) || (triangle.groups[1] == triangle.groups[2]) || (triangle.groups[0] == triangle.groups[2])) { continue; }
+
+		const UInt triangle_index = static_cast<UInt>(triangles.size());
+		triangles.push_back(triangle);
+
+		// Each face contributes its plane to its corners, weighted by area so slivers matter less
+		const vec3& p0 = positions.at(triangle.groups[0]);
+		const vec3 normal = cross(positions.at(triangle.groups[1]) - p0, positions.at(triangle.groups[2]) - p0);
+		const float area = length(normal);
+
+		for (size_t corner = 0; corner < 3; ++corner) {
+			adjacency.at(triangle.groups[corner]).push_back(triangle_index);
+
+			const UInt a = triangle.groups[corner], b = triangle.groups[(corner + 1) % 3];
+			edge_faces[std::make_pair(std::min(a, b), std::max(a, b))].push_back(triangle_index);
+		}
+
+		if (area <= 0.0f) { continue; }
+
+		const vec3 unit_normal = normal / area;
+		const Quadric plane(unit_normal.x, unit_normal.y, unit_normal.z, -dot(unit_normal, p0), area);
+		for (size_t corner = 0; corner < 3; ++corner) { quadrics.at(triangle.groups[corner]) += plane; }
+	}
+
+	// Edges belonging to a single face are on the boundary (e.g. the edge of the terrain), pin them with a perpendicular plane
+	for (std::map<std::pair<UInt, UInt>, std::vector<UInt>>::const_iterator edge = edge_faces.begin(); edge != edge_faces.end(); ++edge) {
+		if (edge->second.size() != 1) { continue; }
+
+		const Triangle& triangle = triangles.at(edge->second.front());
+		const vec3& p0 = positions.at(triangle.groups[0]);
+		const vec3 face_normal = cross(positions.at(triangle.groups[1]) - p0, positions.at(triangle.groups[2]) - p0);
+
+		const vec3& start = positions.at(edge->first.first);
+		const vec3 edge_vector = positions.at(edge->first.second) - start;
+		const vec3 perpendicular = cross(edge_vector, face_normal);
+		if (length_squared(perpendicular) <= 0.0f) { continue; }
+
+		const vec3 unit_perpendicular = normalise(perpendicular);
+		const Quadric plane(unit_perpendicular.x, unit_perpendicular.y, unit_perpendicular.z, -dot(unit_perpendicular, start), BOUNDARY_WEIGHT * length_squared(edge_vector));
+
+		quadrics.at(edge->first.first) += plane;
+		quadrics.at(edge->first.second) += plane;
+	}
+
+	std::vector<UInt> version(positions.size(), 0);
+	std::vector<bool> collapsed(positions.size(), false);
+	std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+	auto push_edge = [&](const UInt& a, const UInt& b) {
+		Quadric combined = quadrics.at(a);
+		combined += quadrics.at(b);
+
+		// Collapse in whichever direction leaves the smaller error
+		const double cost_to_b = combined.evaluate(positions.at(b));
+		const double cost_to_a = combined.evaluate(positions.at(a));
+
+		if (cost_to_b <= cost_to_a) { heap.push({ cost_to_b, a, b, version.at(a), version.at(b) }); }
+		else { heap.push({ cost_to_a, b, a, version.at(b), version.at(a) }); }
+	};
+
+	for (std::map<std::pair<UInt, UInt>, std::vector<UInt>>::const_iterator edge = edge_faces.begin(); edge != edge_faces.end(); ++edge) {
+		push_edge(edge->first.first, edge->first.second);
+	}
+
+	auto contains = [](const Triangle& triangle, const UInt& group) {
+		return (triangle.groups[0] == group) || (triangle.groups[1] == group) || (triangle.groups[2] == group);
+	};
+
+	auto face_normal = [&](const UInt& g0, const UInt& g1, const UInt& g2) {
+		return cross(positions.at(g1) - positions.at(g0), positions.at(g2) - positions.at(g0));
+	};
+
+	size_t live_triangles = triangles.size();
+	while ((live_triangles > target_triangles) && (!heap.empty())) {
+		const Collapse collapse = heap.top();
+		heap.pop();
+
+		// Entries are invalidated lazily: anything touching a changed vertex is stale
+		if (collapsed.at(collapse.from) || collapsed.at(collapse.to)) { continue; }
+		if ((version.at(collapse.from) != collapse.from_version) || (version.at(collapse.to) != collapse.to_version)) { continue; }
+
+		// Reject collapses that would fold a surviving face over
+		bool flips = false;
+		for (size_t i = 0; (i < adjacency.at(collapse.from).size()) && (!flips); ++i) {
+			const Triangle& triangle = triangles.at(adjacency.at(collapse.from).at(i));
+			if (triangle.removed || contains(triangle, collapse.to)) { continue; }
+
+			UInt moved[3] = { triangle.groups[0], triangle.groups[1], triangle.groups[2] };
+			for (size_t corner = 0; corner < 3; ++corner) { if (moved[corner] == collapse.from) { moved[corner] = collapse.to; } }
+
+			const vec3 before = face_normal(triangle.groups[0], triangle.groups[1], triangle.groups[2]);
+			const vec3 after = face_normal(moved[0], moved[1], moved[2]);
+
+			if ((length_squared(after) <= 0.0f) || (length_squared(before) <= 0.0f)) { flips = true; continue; }
+			flips = dot(normalise(before), normalise(after)) < MIN_FACE_ALIGNMENT;
+		}
+
+		if (flips) { continue; }
+
+		for (size_t i = 0; i < adjacency.at(collapse.from).size(); ++i) {
+			const UInt triangle_index = adjacency.at(collapse.from).at(i);
+			Triangle& triangle = triangles.at(triangle_index);
+			if (triangle.removed) { continue; }
+
+			if (contains(triangle, collapse.to)) {
+				triangle.removed = true;
+				live_triangles--;
+				continue;
+			}
+
+			for (size_t corner = 0; corner < 3; ++corner) { if (triangle.groups[corner] == collapse.from) { triangle.groups[corner] = collapse.to; } }
+			adjacency.at(collapse.to).push_back(triangle_index);
+		}
+
+		quadrics.at(collapse.to) += quadrics.at(collapse.from);
+		collapsed.at(collapse.from) = true;
+		adjacency.at(collapse.from).clear();
+		version.at(collapse.to)++;
+
+		// Prune dead faces and re-queue every edge around the surviving vertex
+		std::vector<UInt> live_adjacent;
+		std::vector<UInt> neighbours;
+		for (size_t i = 0; i < adjacency.at(collapse.to).size(); ++i) {
+			const UInt triangle_index = adjacency.at(collapse.to).at(i);
+			const Triangle& triangle = triangles.at(triangle_index);
+			if (triangle.removed) { continue; }
+
+			live_adjacent.push_back(triangle_index);
+			for (size_t corner = 0; corner < 3; ++corner) {
+				const UInt neighbour = triangle.groups[corner];
+				if ((neighbour != collapse.to) && (std::find(neighbours.begin(), neighbours.end(), neighbour) == neighbours.end())) {
+					neighbours.push_back(neighbour);
+				}
+			}
+		}
+
+		adjacency.at(collapse.to) = live_adjacent;
+		for (size_t i = 0; i < neighbours.size(); ++i) { push_edge(collapse.to, neighbours.at(i)); }
+	}
+
+	// Map each surviving corner back onto a real vertex, picking the member of the group whose normal best matches
+	std::vector<UInt> simplified_indices;
+	simplified_indices.reserve(live_triangles * 3);
+
+	for (size_t i = 0; i < triangles.size(); ++i) {
+		const Triangle& triangle = triangles.at(i);
+		if (triangle.removed) { continue; }
+
+		for (size_t corner = 0; corner < 3; ++corner) {
+			const UInt original = triangle.corners[corner];
+			const UInt group = triangle.groups[corner];
+
+			if (vertex_group.at(original) == group) {
+				simplified_indices.push_back(original);
+				continue;
+			}
+
+			const std::vector<UInt>& members = group_members.at(group);
+			UInt best = members.front();
+			float best_alignment = -2.0f;
+
+			for (size_t member = 0; member < members.size(); ++member) {
+				const float alignment = dot(vertices.at(original).normal, vertices.at(members.at(member)).normal);
+				if (alignment > best_alignment) {
+					best_alignment = alignment;
+					best = members.at(member);
+				}
+			}
+
+			simplified_indices.push_back(best);
+		}
+	}
+
+	return simplified_indices;
+}
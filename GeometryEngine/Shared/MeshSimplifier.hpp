@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Mesh.hpp"
+
+class MeshSimplifier {
+	// Quadric error metric edge collapse (Garland & Heckbert)
+	// Edges are collapsed onto one of their existing end points, so the returned indices still
+	// reference the original vertex array and every level of detail can share a single vertex buffer
+
+public:
+	// Returns a reduced index list containing roughly target_ratio of the original triangles
+	static std::vector<UInt> simplify(const std::vector<MeshVertex>& vertices, const std::vector<UInt>& indices, const float& target_ratio);
+
+private:
+	struct Quadric {
+		// Upper triangle of the symmetric 4x4 error matrix
+		double a[10] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+		Quadric() {}
+		Quadric(const double& a, const double& b, const double& c, const double& d, const double& weight);
+
+		Quadric& operator+=(const Quadric& other);
+		double evaluate(const vec3& point) const;
+	};
+
+	struct Collapse {
+		double cost;
+		UInt from;
+		UInt to;
+		UInt from_version;
+		UInt to_version;
+
+		inline bool operator>(const Collapse& other) const { return cost > other.cost; }
+	};
+
+	// Boundary edges are held in place by a perpendicular plane with this weight
+	static const double BOUNDARY_WEIGHT;
+
+	// Collapses that rotate a neighbouring face further than this (cosine) are rejected
+	static const float MIN_FACE_ALIGNMENT;
+};
@@ -1,12 +1,22 @@
 #include "Model.hpp"
+#include "MeshSimplifier.hpp"
 
 std::vector<MeshTexture> Model::loaded_textures = {};
 int Model::model_count = 0;
 
+std::map<std::string, std::vector<std::vector<std::vector<UInt>>>> Model::lod_cache = {};
+const std::vector<float> Model::LOD_RATIOS = { 0.5f, 0.25f, 0.1f };
+const size_t Model::MIN_LOD_TRIANGLES = 64;
+
+bool Model::lod_view_set = false;
+vec3 Model::lod_view_position;
+float Model::lod_projection_scale = 0.0f;
+
 Model::Model(const std::string& model_path) : Shape(), model_file_path(model_path) {
     if (!boost::filesystem::exists(model_path)){ throw std::runtime_error("Model at: " + model_path + " does not exist"); }
     
     load();
+	generate_lods();
 	Model::model_count++;
 }
 
@@ -43,6 +53,43 @@ void Model::load(){
     process_node(scene->mRootNode, scene);
 }
 
+void Model::generate_lods() {
+	std::map<std::string, std::vector<std::vector<std::vector<UInt>>>>::iterator cached = lod_cache.find(model_file_path);
+
+	if (cached == lod_cache.end()) {
+		std::vector<std::vector<std::vector<UInt>>> model_lods;
+
+		for (size_t mesh_iter = 0; mesh_iter < meshes.size(); ++mesh_iter) {
+			const Mesh& mesh = meshes.at(mesh_iter);
+			std::vector<std::vector<UInt>> mesh_lods;
+
+			if ((mesh.get_indices().size() / 3) >= MIN_LOD_TRIANGLES) {
+				for (size_t lod_iter = 0; lod_iter < LOD_RATIOS.size(); ++lod_iter) {
+					mesh_lods.push_back(MeshSimplifier::simplify(mesh.get_vertices(), mesh.get_indices(), LOD_RATIOS.at(lod_iter)));
+				}
+			}
+
+			model_lods.push_back(mesh_lods);
+		}
+
+		cached = lod_cache.insert(std::make_pair(model_file_path, model_lods)).first;
+	}
+
+	for (size_t mesh_iter = 0; mesh_iter < meshes.size(); ++mesh_iter) {
+		meshes.at(mesh_iter).set_lods(cached->second.at(mesh_iter));
+	}
+}
+
+void Model::set_lod_view(const vec3& view_position, const float& projection_scale) {
+	lod_view_set = true;
+	lod_view_position = view_position;
+	lod_projection_scale = projection_scale;
+}
+
+void Model::clear_lod_view() {
+	lod_view_set = false;
+}
+
 void Model::process_node(aiNode* node, const aiScene* scene){
     // Using recursion instead of iteration because this defines a unique parent-child structure
     
@@ -143,13 +190,31 @@ void Model::load_texture(std::vector<MeshTexture>& load_vector, aiMaterial* mate
 }
 
 void Model::render(const SHADER_ID& id){
-    evaluate_changed();
+	update_meshes();
     
     for (size_t mesh_index = 0; mesh_index < meshes.size(); mesh_index++){
         meshes.at(mesh_index).render(id);
     }
 }
 
+bool Model::is_transparent() {
+	for (size_t mesh_index = 0; mesh_index < meshes.size(); mesh_index++) {
+		if (meshes.at(mesh_index).is_transparent()) { return true; }
+	}
+
+	return false;
+}
+
+void Model::update_meshes() {
+	evaluate_changed();
+	if (!lod_view_set) { return; }
+
+	// Selected per mesh, so large multi-mesh models (the terrain) can coarsen their distant parts
+	for (size_t mesh_index = 0; mesh_index < meshes.size(); mesh_index++) {
+		meshes.at(mesh_index).update_lod(lod_view_position, lod_projection_scale);
+	}
+}
+
 void Model::evaluate_changed(){
 	if (matrix_needs_update) { _needs_evaluation = true; }
     if (!_needs_evaluation){ return; }
@@ -13,10 +13,26 @@ public:
 	virtual ~Model();
     
     virtual void render(const SHADER_ID& id);
+
+	// Transparent if any of its meshes are
+	virtual bool is_transparent();
+
+	// Brings every mesh's transform up to date and picks its level of detail, render() does this itself
+	void update_meshes();
     
     std::vector<Mesh> meshes;
 
 	virtual std::vector<vec3> get_personal_vertices();
+
+	inline const std::string& get_file_path() const { return model_file_path; }
+
+	// Meshes choose their level of detail relative to this view until it is cleared (full detail otherwise)
+	static void set_lod_view(const vec3& view_position, const float& projection_scale);
+	static void clear_lod_view();
+
+	static inline bool has_lod_view() { return lod_view_set; }
+	static inline vec3 get_lod_view_position() { return lod_view_position; }
+	static inline float get_lod_projection_scale() { return lod_projection_scale; }
     
 protected:
     virtual void evaluate_changed();
@@ -28,8 +44,22 @@ private:
 	// This container is static so that if other models use the exact same textures, they don't need to be loaded more than once
     static std::vector<MeshTexture> loaded_textures;
 	static int model_count;
+
+	// Simplified index lists per model file, per mesh, so every instance of a model shares one bake
+	static std::map<std::string, std::vector<std::vector<std::vector<UInt>>>> lod_cache;
+
+	// Target triangle ratios of each generated level of detail
+	static const std::vector<float> LOD_RATIOS;
+
+	// Meshes smaller than this aren't worth simplifying
+	static const size_t MIN_LOD_TRIANGLES;
+
+	static bool lod_view_set;
+	static vec3 lod_view_position;
+	static float lod_projection_scale;
     
     void load();
+	void generate_lods();
     void process_node(aiNode* node, const aiScene* scene);
     Mesh process_mesh(aiMesh* mesh, const aiScene* scene);
     void load_texture(std::vector<MeshTexture>& load_vector, aiMaterial* material, aiTextureType type, const std::string& type_name);
@@ -0,0 +1,58 @@
+#include "OcclusionQuery.hpp"
+
+
+OcclusionQuery::OcclusionQuery() {
+	glGenQueries(1, &query);
+}
+
+OcclusionQuery::~OcclusionQuery() {
+	glDeleteQueries(1, &query);
+}
+
+void OcclusionQuery::update() {
+	if (!in_flight) { return; }
+
+	int available = 0;
+	glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) { return; }
+
+	UInt samples_passed = 0;
+	glGetQueryObjectuiv(query, GL_QUERY_RESULT, &samples_passed);
+
+	visible = samples_passed != 0;
+	in_flight = false;
+}
+
+bool OcclusionQuery::begin() {
+	if (in_flight) { return false; }
+
+	glBeginQuery(get_query_target(), query);
+	return true;
+}
+
+void OcclusionQuery::end() {
+	glEndQuery(get_query_target());
+	in_flight = true;
+}
+
+UInt OcclusionQuery::get_query_target() {
+	static UInt target = 0;
+
+	if (!target) {
+		target = GL_ANY_SAMPLES_PASSED;
+
+#ifdef GL_ANY_SAMPLES_PASSED_CONSERVATIVE
+		// Core in 4.3, the context may be newer than the 3.3 that is requested
+		int major = 0;
+		int minor = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+		if ((major > 4) || ((major == 4) && (minor >= 3))) {
+			target = GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
+		}
+#endif
+	}
+
+	return target;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+class OcclusionQuery {
+	/*
+	Wraps a single 'any samples passed' query for occlusion culling
+
+	Usage per frame:
+		update()		- Collects the result of the last query if the GPU has finished it
+		begin() / end()	- Wrapped around a cheap proxy draw, skipped while a query is still in flight
+		is_visible()	- Last known result, so culling decisions lag one frame behind without stalling
+	*/
+
+public:
+	OcclusionQuery();
+	~OcclusionQuery();
+
+	OcclusionQuery(const OcclusionQuery& other) = delete;
+	void operator=(const OcclusionQuery& other) = delete;
+
+	void update();
+
+	// Returns false if no query was started, in which case end() must not be called
+	bool begin();
+	void end();
+
+	inline bool is_visible() const { return visible; }
+	inline void set_visible(const bool new_visible) { visible = new_visible; }
+
+	// GL_ANY_SAMPLES_PASSED_CONSERVATIVE where supported, otherwise GL_ANY_SAMPLES_PASSED
+	static UInt get_query_target();
+
+private:
+	UInt query = 0;
+	bool in_flight = false;
+	bool visible = true;
+};
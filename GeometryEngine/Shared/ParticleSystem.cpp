@@ -0,0 +1,178 @@
+#include "ParticleSystem.hpp"
+#include "ResourceHandler.hpp"
+
+
+ParticleSystem::ParticleSystem() {
+	for (size_t slot_iter = 0; slot_iter < slots.size(); ++slot_iter) {
+		slots[slot_iter] = { ParticleEmitter(), 0.0f, 0.0f, false, true };
+	}
+
+	const std::vector<float> empty_particles(MAX_EMITTERS * PARTICLES_PER_EMITTER * FLOATS_PER_PARTICLE, 0.0f);
+
+	glGenBuffers(2, buffers);
+	glGenVertexArrays(2, update_VAOs);
+	glGenVertexArrays(2, render_VAOs);
+
+	for (size_t buffer_iter = 0; buffer_iter < 2; ++buffer_iter) {
+		glBindBuffer(GL_ARRAY_BUFFER, buffers[buffer_iter]);
+		glBufferData(GL_ARRAY_BUFFER, empty_particles.size() * sizeof(float), &empty_particles[0], GL_DYNAMIC_COPY);
+
+		// Simulation reads one vertex per particle
+		glBindVertexArray(update_VAOs[buffer_iter]);
+		setup_attributes();
+
+		// Rendering reads one instance per particle, the quad corners come from gl_VertexID
+		glBindVertexArray(render_VAOs[buffer_iter]);
+		setup_attributes();
+		glVertexAttribDivisor(0, 1);
+		glVertexAttribDivisor(1, 1);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	ResourceHandler& instance = ResourceHandler::get_instance();
+	instance.get_program(UPDATE_ID()).set_uniform<int>("particles_per_emitter", PARTICLES_PER_EMITTER);
+	instance.get_program(RENDER_ID()).set_uniform<int>("particles_per_emitter", PARTICLES_PER_EMITTER);
+}
+
+ParticleSystem::~ParticleSystem() {
+	glDeleteVertexArrays(2, update_VAOs);
+	glDeleteVertexArrays(2, render_VAOs);
+	glDeleteBuffers(2, buffers);
+}
+
+void ParticleSystem::setup_attributes() {
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, FLOATS_PER_PARTICLE * sizeof(float), nullptr);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, FLOATS_PER_PARTICLE * sizeof(float), (void*)(4 * sizeof(float)));
+}
+
+int ParticleSystem::find_free_slot() const {
+	for (size_t slot_iter = 0; slot_iter < slots.size(); ++slot_iter) {
+		const EmitterSlot& slot = slots[slot_iter];
+
+		// A slot can only be reused once all of its particles have died
+		if (!slot.in_use && (time >= slot.free_at)) { return static_cast<int>(slot_iter); }
+	}
+
+	return -1;
+}
+
+int ParticleSystem::add_emitter(const ParticleEmitter& emitter) {
+	const int handle = find_free_slot();
+	if (handle < 0) { return handle; }
+
+	slots[handle] = { emitter, std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), true, true };
+	return handle;
+}
+
+void ParticleSystem::set_emitter_position(const int& handle, const vec3& position) {
+	if (handle < 0) { return; }
+
+	slots.at(handle).emitter.position = position;
+	slots.at(handle).dirty = true;
+}
+
+void ParticleSystem::stop_emitter(const int& handle) {
+	if (handle < 0) { return; }
+
+	EmitterSlot& slot = slots.at(handle);
+	slot.emit_until = time;
+	slot.free_at = time + slot.emitter.lifetime;
+	slot.in_use = false;
+	slot.dirty = true;
+}
+
+void ParticleSystem::burst(const ParticleEmitter& emitter, const float& duration) {
+	const int handle = find_free_slot();
+	if (handle < 0) { return; }
+
+	slots[handle] = { emitter, time + duration, time + duration + emitter.lifetime, false, true };
+}
+
+void ParticleSystem::clear() {
+	const std::vector<float> empty_particles(MAX_EMITTERS * PARTICLES_PER_EMITTER * FLOATS_PER_PARTICLE, 0.0f);
+
+	for (size_t buffer_iter = 0; buffer_iter < 2; ++buffer_iter) {
+		glBindBuffer(GL_ARRAY_BUFFER, buffers[buffer_iter]);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, empty_particles.size() * sizeof(float), &empty_particles[0]);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	for (size_t slot_iter = 0; slot_iter < slots.size(); ++slot_iter) {
+		slots[slot_iter] = { ParticleEmitter(), 0.0f, 0.0f, false, true };
+	}
+}
+
+void ParticleSystem::upload_emitter(const size_t& index) {
+	const EmitterSlot& slot = slots.at(index);
+	const std::string name = "emitters[" + std::to_string(index) + "]";
+
+	ResourceHandler& instance = ResourceHandler::get_instance();
+	Program& update_program = instance.get_program(UPDATE_ID());
+	Program& render_program = instance.get_program(RENDER_ID());
+
+	update_program.set_uniform<vec3>(name + ".position", slot.emitter.position);
+	update_program.set_uniform<vec3>(name + ".velocity", slot.emitter.velocity);
+	update_program.set_uniform<float>(name + ".spread", slot.emitter.spread);
+	update_program.set_uniform<float>(name + ".lifetime", slot.emitter.lifetime);
+	update_program.set_uniform<float>(name + ".gravity", slot.emitter.gravity);
+	update_program.set_uniform<float>(name + ".emit_until", slot.emit_until);
+
+	render_program.set_uniform<vec3>(name + ".colour", slot.emitter.colour);
+	render_program.set_uniform<float>(name + ".size", slot.emitter.size);
+}
+
+void ParticleSystem::update(const float& time_delta) {
+	time += time_delta;
+
+	for (size_t slot_iter = 0; slot_iter < slots.size(); ++slot_iter) {
+		if (!slots[slot_iter].dirty) { continue; }
+
+		upload_emitter(slot_iter);
+		slots[slot_iter].dirty = false;
+	}
+
+	Program& program = ResourceHandler::get_instance().get_program(UPDATE_ID());
+	program.set_uniform<float>("time", time);
+	program.set_uniform<float>("time_delta", time_delta);
+
+	const size_t next = 1 - current;
+
+	glEnable(GL_RASTERIZER_DISCARD);
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers[next]);
+
+	glBindVertexArray(update_VAOs[current]);
+	glBeginTransformFeedback(GL_POINTS);
+	glDrawArrays(GL_POINTS, 0, MAX_EMITTERS * PARTICLES_PER_EMITTER);
+	glEndTransformFeedback();
+	glBindVertexArray(0);
+
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+	glDisable(GL_RASTERIZER_DISCARD);
+
+	current = next;
+}
+
+void ParticleSystem::render(const mat4& view, const mat4& projection) {
+	Program& program = ResourceHandler::get_instance().get_program(RENDER_ID());
+	program.set_uniform<mat4>("view", view);
+	program.set_uniform<mat4>("projection", projection);
+
+	// Additive and unsorted, so particles must not write depth
+	const bool blending = glIsEnabled(GL_BLEND) == GL_TRUE;
+	glEnable(GL_BLEND);
+	glDepthMask(GL_FALSE);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+	glBindVertexArray(render_VAOs[current]);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, MAX_EMITTERS * PARTICLES_PER_EMITTER);
+	glBindVertexArray(0);
+
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDepthMask(GL_TRUE);
+	if (!blending) { glDisable(GL_BLEND); }
+}
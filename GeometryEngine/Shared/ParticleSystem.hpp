@@ -0,0 +1,84 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+struct ParticleEmitter {
+	vec3 position;
+	vec3 velocity;		// Shared by every particle when spawned
+	vec3 colour;
+
+	float spread;		// Random speed added in every direction
+	float lifetime;		// Longest a particle can live, in seconds
+	float size;
+	float gravity;
+};
+
+class ParticleSystem {
+	/*
+	GPU particles simulated with transform feedback and drawn as instanced billboards
+
+	The particle buffer is split evenly between a fixed number of emitter slots. Particles are
+	simulated, respawned and faded entirely on the GPU; the CPU only uploads emitter uniforms
+	when an emitter changes. Every particle is updated with one draw and rendered with one draw,
+	however many emitters are active.
+
+	Compute shaders are not used as they are not available on every supported platform (OSX is capped at 4.1)
+	*/
+
+	// Per particle: vec4(position, remaining life) + vec4(velocity, starting life)
+	static const UInt FLOATS_PER_PARTICLE = 8;
+
+public:
+	static const UInt MAX_EMITTERS = 32;
+	static const UInt PARTICLES_PER_EMITTER = 256;
+
+	inline static SHADER_ID UPDATE_ID() { return "ParticleUpdate"; }
+	inline static SHADER_ID RENDER_ID() { return "Particle"; }
+
+	static ParticleSystem& get_instance() {
+		static ParticleSystem instance;
+		return instance;
+	}
+
+	ParticleSystem(const ParticleSystem& other) = delete;
+	void operator=(const ParticleSystem& other) = delete;
+
+	// Emits until stopped, returns -1 if every slot is in use
+	int add_emitter(const ParticleEmitter& emitter);
+	void set_emitter_position(const int& handle, const vec3& position);
+	void stop_emitter(const int& handle);
+
+	// Emits for a fixed time then frees itself once its particles have died
+	void burst(const ParticleEmitter& emitter, const float& duration);
+
+	// Kills every particle and frees every slot
+	void clear();
+
+	void update(const float& time_delta);
+	void render(const mat4& view, const mat4& projection);
+
+private:
+	ParticleSystem();
+	~ParticleSystem();
+
+	struct EmitterSlot {
+		ParticleEmitter emitter;
+		float emit_until;
+		float free_at;
+		bool in_use;
+		bool dirty;
+	};
+
+	std::array<EmitterSlot, MAX_EMITTERS> slots;
+	float time = 0.0f;
+
+	// Ping-pong buffers, one is read while the other is written
+	UInt buffers[2];
+	UInt update_VAOs[2];
+	UInt render_VAOs[2];
+	size_t current = 0;
+
+	int find_free_slot() const;
+	void upload_emitter(const size_t& index);
+	static void setup_attributes();
+};
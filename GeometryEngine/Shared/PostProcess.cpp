@@ -0,0 +1,50 @@
+#include "PostProcess.hpp"
+#include "ResourceHandler.hpp"
+
+
+PostProcess::PostProcess(const UInt& width, const UInt& height) :
+target(width, height, {
+	{ GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE }
+}) {
+	set_linear_filtering();
+}
+
+void PostProcess::begin(const UInt& width, const UInt& height, const float& scale) {
+	const UInt scaled_width = std::max(static_cast<UInt>(width * scale), 1u);
+	const UInt scaled_height = std::max(static_cast<UInt>(height * scale), 1u);
+
+	if ((scaled_width != target.get_width()) || (scaled_height != target.get_height())) {
+		target.resize(scaled_width, scaled_height);
+		set_linear_filtering();
+	}
+
+	target.bind();
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void PostProcess::end(const UInt& width, const UInt& height, const bool anti_alias) {
+	RenderTarget::unbind();
+	glViewport(0, 0, width, height);
+
+	Program& program = ResourceHandler::get_instance().get_program(anti_alias ? FXAA_ID() : UPSCALE_ID());
+	target.bind_colour_texture(0, 0);
+	program.set_uniform<int>("scene", 0);
+
+	// FXAA works on the target's pixels, which are larger than the window's when scaled down
+	if (anti_alias) {
+		program.set_uniform<vec2>("inverse_screen_size", vec2(1.0f / static_cast<float>(target.get_width()), 1.0f / static_cast<float>(target.get_height())));
+	}
+
+	glDisable(GL_DEPTH_TEST);
+	RenderTarget::draw_fullscreen();
+	glEnable(GL_DEPTH_TEST);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void PostProcess::set_linear_filtering() {
+	glBindTexture(GL_TEXTURE_2D, target.get_colour_texture(0));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "RenderTarget.hpp"
+
+
+class PostProcess {
+	/*
+	Anti-aliasing and resolution scaling applied to the finished frame
+
+	begin() redirects drawing into an offscreen colour target, optionally smaller than the window,
+	and end() draws it to the default framebuffer in one full screen pass, upscaled with FXAA or
+	plain filtering. Unlike MSAA the cost of FXAA does not grow with the cost of the scene's
+	shading, and it can be switched on and off without recreating the window
+	*/
+
+public:
+	inline static SHADER_ID FXAA_ID() { return "FXAA"; }
+	inline static SHADER_ID UPSCALE_ID() { return "Upscale"; }
+
+	PostProcess(const UInt& width, const UInt& height);
+
+	PostProcess(const PostProcess& other) = delete;
+	void operator=(const PostProcess& other) = delete;
+
+	// Binds and clears the offscreen target, resizing it to the window's size times the scale if needed
+	void begin(const UInt& width, const UInt& height, const float& scale = 1.0f);
+
+	// Draws the result to the default framebuffer, which is the window's size
+	void end(const UInt& width, const UInt& height, const bool anti_alias = true);
+
+	// For passes that finish by copying into a framebuffer of their own choosing (DeferredRenderer::composite)
+	inline const RenderTarget& get_target() const { return target; }
+
+private:
+	RenderTarget target;
+
+	// FXAA samples between pixels, so the target is filtered rather than point sampled
+	void set_linear_filtering();
+};
@@ -22,14 +22,7 @@ void Program::_link_program_id(const UInt& vertex_id, const UInt& fragment_id, c
     }
     
     glLinkProgram(program_id);
-    
-    int success;
-    glGetProgramiv(program_id, GL_LINK_STATUS, &success);
-    if (success == 0) {
-        char info_log[READ_BUFFER_SIZE];
-        glGetProgramInfoLog(program_id, READ_BUFFER_SIZE, nullptr, info_log);
-        throw std::runtime_error(std::string(info_log));
-    }
+    check_link_status(program_id);
     
     _program_id = program_id;
 }
@@ -67,6 +60,16 @@ UInt Program::_compile_shader_string(const UInt& shader_type, const std::string&
 	return shader_id;
 }
 
+void Program::check_link_status(const UInt& id) {
+    int success;
+    glGetProgramiv(id, GL_LINK_STATUS, &success);
+    if (success == 0) {
+        char info_log[READ_BUFFER_SIZE];
+        glGetProgramInfoLog(id, READ_BUFFER_SIZE, nullptr, info_log);
+        throw std::runtime_error(std::string(info_log));
+    }
+}
+
 void Program::check_compile_status(const UInt& id) {
     int success;
     glGetShaderiv(id, GL_COMPILE_STATUS, &success);
@@ -27,6 +27,12 @@ namespace Uniforms {
         set_uniform<int>(id, uniform_name, value ? 1 : 0, use_program);
     }
     
+    template <>
+    inline void set_uniform<vec2>(const UInt& id, const std::string& uniform_name, const vec2& value, bool use_program) {
+        if (use_program) { glUseProgram(id); }
+        glUniform2f(glGetUniformLocation(id, uniform_name.c_str()), value.x, value.y);
+    }
+    
     template <>
     inline void set_uniform<vec3>(const UInt& id, const std::string& uniform_name, const vec3& value, bool use_program) {
         if (use_program) { glUseProgram(id); }
@@ -67,6 +73,17 @@ public:
         Uniforms::set_uniform<T>(_program_id, uniform_name, value, use_program);
     }
 
+    // For state that outlives a draw (view, lights, far plane), programs that swap between several GL programs replay it onto the others
+    // Per-draw uniforms such as 'model' and the material are set with set_uniform after any switch, so are never recorded
+    template <typename T>
+    inline void set_persistent_uniform(const std::string& uniform_name, const T& value) {
+        Uniforms::set_uniform<T>(_program_id, uniform_name, value, true);
+
+        if (_records_uniforms) {
+            _record_uniform(uniform_name, [uniform_name, value](const UInt& id) { Uniforms::set_uniform<T>(id, uniform_name, value, true); });
+        }
+    }
+
 private:
 	void _link_program(const std::string& vertex, const std::string& fragment, const std::string& geo = std::string());
     
@@ -76,8 +93,13 @@ private:
 protected:
 	inline Program() {}
     UInt _program_id;
+
+    // Programs that swap between several GL programs record uniforms so they can be replayed onto the others
+    bool _records_uniforms = false;
+    virtual void _record_uniform(const std::string& uniform_name, const std::function<void(const UInt&)>& apply) {}
     
     void _link_program_id(const UInt& vertex_id, const UInt& fragment_id, const long& geometry_id = -1);
 	static UInt _compile_shader_string(const UInt& shader_type, const std::string& shader_string);
+    static void check_link_status(const UInt& id);
 };
 
@@ -0,0 +1,45 @@
+#include "QualityGovernor.hpp"
+
+const float QualityGovernor::RAISE_HEADROOM = 0.85f;
+
+
+QualityGovernor::QualityGovernor(const std::vector<QualityLevel>& levels, const float& target_frame_time) :
+levels(levels), target_frame_time(target_frame_time) {
+
+	if (levels.empty()) { throw std::runtime_error("A quality governor needs at least one quality level"); }
+}
+
+bool QualityGovernor::update(const float& gpu_time) {
+	if (settle_frames > 0) {
+		--settle_frames;
+		return false;
+	}
+
+	if ((gpu_time > target_frame_time) && ((current_level + 1) < levels.size())) {
+		frames_under = 0;
+		return (++frames_over >= FRAMES_TO_LOWER) ? change_level(current_level + 1) : false;
+	}
+
+	frames_over = 0;
+	if (current_level == 0) { return false; }
+
+	// The next level up mostly costs more pixels, the rest of its cost is left to the headroom
+	const float scale_ratio = levels.at(current_level - 1).render_scale / levels.at(current_level).render_scale;
+	const float predicted_gpu_time = gpu_time * scale_ratio * scale_ratio;
+
+	if (predicted_gpu_time < (target_frame_time * RAISE_HEADROOM)) {
+		return (++frames_under >= FRAMES_TO_RAISE) ? change_level(current_level - 1) : false;
+	}
+
+	frames_under = 0;
+	return false;
+}
+
+bool QualityGovernor::change_level(const size_t& new_level) {
+	current_level = new_level;
+	frames_over = 0;
+	frames_under = 0;
+	settle_frames = SETTLE_FRAMES;
+
+	return true;
+}
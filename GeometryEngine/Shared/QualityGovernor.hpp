@@ -0,0 +1,49 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+struct QualityLevel {
+	float render_scale;			// Of the window's resolution, the 3D scene is upscaled when below one
+	UInt shadow_resolution;		// Of each shadow cube map face
+	UInt shadow_quality_tier;	// LightMapFeatures::LOW_QUALITY to HIGH_QUALITY
+};
+
+class QualityGovernor {
+	/*
+	Steps through quality levels to hold a target frame time
+
+	Levels are ordered from best to cheapest. A level is dropped once the GPU has been over budget
+	for FRAMES_TO_LOWER frames in a row, and raised once the next level up is predicted to fit with
+	some headroom (scaling the GPU time by its extra pixels) for FRAMES_TO_RAISE frames in a row.
+	Raising takes far longer than dropping and timings are ignored for a while after any change,
+	so the level does not flip back and forth. Only the GPU's share of the frame is affected by
+	these settings, so frames that are slow on the CPU alone never lower the quality
+	*/
+
+public:
+	QualityGovernor(const std::vector<QualityLevel>& levels, const float& target_frame_time);
+
+	// Called once a frame with the GPU's frame time in milliseconds, returns true if the level changed
+	bool update(const float& gpu_time);
+
+	inline const QualityLevel& get_level() const { return levels.at(current_level); }
+	inline size_t get_level_index() const { return current_level; }
+	inline size_t get_level_count() const { return levels.size(); }
+	inline float get_target_frame_time() const { return target_frame_time; }
+
+private:
+	static const UInt FRAMES_TO_LOWER = 30;
+	static const UInt FRAMES_TO_RAISE = 240;
+	static const UInt SETTLE_FRAMES = 30;	// Long enough for the smoothed timings to reflect the new level
+	static const float RAISE_HEADROOM;
+
+	std::vector<QualityLevel> levels;
+	float target_frame_time;
+
+	size_t current_level = 0;
+	UInt frames_over = 0;
+	UInt frames_under = 0;
+	UInt settle_frames = 0;
+
+	bool change_level(const size_t& new_level);
+};
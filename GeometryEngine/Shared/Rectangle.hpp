@@ -11,6 +11,7 @@ public:
 
     virtual inline ~Rect() {}
     virtual void render(const SHADER_ID& id);
+	virtual bool is_transparent();
     virtual inline void set_texture(const UInt& new_tex) { texture = new_tex; }
             
 protected:
@@ -0,0 +1,63 @@
+#include "RenderQueue.hpp"
+
+
+void RenderQueue::submit(Renderable& renderable, const SHADER_ID& id) {
+	if (!renderable.is_transparent()) {
+		opaque_items.push_back({ &renderable, id, std::function<void()>(), vec3() });
+		return;
+	}
+
+	// Renderables that cannot be placed are sorted as if they were at the origin
+	Transformable* transformable = dynamic_cast<Transformable*>(&renderable);
+	transparent_items.push_back({ &renderable, id, std::function<void()>(), transformable ? transformable->get_position() : vec3() });
+}
+
+void RenderQueue::submit_transparent(const vec3& position, const std::function<void()>& draw) {
+	transparent_items.push_back({ nullptr, SHADER_ID(), draw, position });
+}
+
+void RenderQueue::submit_overlay(Renderable& renderable, const SHADER_ID& id) {
+	overlay_items.push_back({ &renderable, id, std::function<void()>(), vec3() });
+}
+
+void RenderQueue::flush(const vec3& view_position) {
+	glDisable(GL_BLEND);
+
+	for (size_t iter = 0; iter < opaque_items.size(); ++iter) {
+		draw_item(opaque_items.at(iter));
+	}
+
+	// Furthest first, so nearer surfaces blend over what is behind them
+	std::stable_sort(transparent_items.begin(), transparent_items.end(), [&view_position](const Item& first, const Item& second) {
+		return length_squared(first.position - view_position) > length_squared(second.position - view_position);
+	});
+
+	glEnable(GL_BLEND);
+	glDepthMask(GL_FALSE);
+
+	for (size_t iter = 0; iter < transparent_items.size(); ++iter) {
+		draw_item(transparent_items.at(iter));
+	}
+
+	glDepthMask(GL_TRUE);
+	glDisable(GL_BLEND);
+
+	opaque_items.clear();
+	transparent_items.clear();
+}
+
+void RenderQueue::flush_overlays() {
+	glEnable(GL_BLEND);
+
+	for (size_t iter = 0; iter < overlay_items.size(); ++iter) {
+		draw_item(overlay_items.at(iter));
+	}
+
+	glDisable(GL_BLEND);
+	overlay_items.clear();
+}
+
+void RenderQueue::draw_item(const Item& item) {
+	if (item.draw) { item.draw(); }
+	else { item.renderable->render(item.id); }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Shape.hpp"
+
+
+class RenderQueue {
+	/*
+	Orders a frame's draws so that blending is only paid for where it is needed
+
+	Blending is off by default. flush() draws the opaque renderables first, in submission order,
+	then the transparent ones (text, particles and anything with a translucent texture) with
+	blending on and depth writes off, sorted back to front from the view position so that they
+	composite correctly over each other. Overlays (the HUD) are drawn in submission order by
+	flush_overlays(), separately so that they can go over an upscaled scene at full resolution.
+
+	Renderables are only referenced, so they must outlive the flush
+	*/
+
+public:
+	RenderQueue() {}
+
+	RenderQueue(const RenderQueue& other) = delete;
+	void operator=(const RenderQueue& other) = delete;
+
+	// Goes to the opaque or transparent list depending on Renderable::is_transparent()
+	void submit(Renderable& renderable, const SHADER_ID& id = SHADER_ID());
+
+	// For transparent draws that are not a single renderable (the particle system), sorted by the given position
+	void submit_transparent(const vec3& position, const std::function<void()>& draw);
+
+	void submit_overlay(Renderable& renderable, const SHADER_ID& id = SHADER_ID());
+
+	// Draws and then clears the queued opaque and transparent items, leaving blending off
+	void flush(const vec3& view_position);
+	void flush_overlays();
+
+private:
+	struct Item {
+		Renderable* renderable;
+		SHADER_ID id;
+		std::function<void()> draw;	// Used instead of the renderable when set
+		vec3 position;
+	};
+
+	std::vector<Item> opaque_items;
+	std::vector<Item> transparent_items;
+	std::vector<Item> overlay_items;
+
+	static void draw_item(const Item& item);
+};
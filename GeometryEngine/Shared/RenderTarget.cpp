@@ -0,0 +1,124 @@
+#include "RenderTarget.hpp"
+
+
+RenderTarget::RenderTarget(const UInt& width, const UInt& height, const std::vector<RenderTargetAttachment>& colour_attachments, const bool use_depth) :
+attachments(colour_attachments), width(width), height(height), use_depth(use_depth) {
+
+	create();
+}
+
+RenderTarget::~RenderTarget() {
+	destroy();
+}
+
+void RenderTarget::resize(const UInt& new_width, const UInt& new_height) {
+	if ((new_width == width) && (new_height == height)) { return; }
+
+	width = new_width;
+	height = new_height;
+
+	destroy();
+	create();
+}
+
+void RenderTarget::bind() const {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, width, height);
+}
+
+void RenderTarget::unbind() {
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderTarget::draw_to_all() const {
+	std::vector<size_t> indices;
+	for (size_t iter = 0; iter < colour_textures.size(); ++iter) { indices.push_back(iter); }
+
+	draw_to(indices);
+}
+
+void RenderTarget::draw_to(const std::vector<size_t>& attachment_indices) const {
+	if (attachment_indices.empty()) {
+		glDrawBuffer(GL_NONE);
+		return;
+	}
+
+	std::vector<UInt> draw_buffers;
+	for (size_t iter = 0; iter < attachment_indices.size(); ++iter) {
+		draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + static_cast<UInt>(attachment_indices.at(iter)));
+	}
+
+	glDrawBuffers(static_cast<int>(draw_buffers.size()), &draw_buffers[0]);
+}
+
+void RenderTarget::bind_colour_texture(const size_t& index, const UInt& texture_unit) const {
+	glActiveTexture(GL_TEXTURE0 + texture_unit);
+	glBindTexture(GL_TEXTURE_2D, colour_textures.at(index));
+}
+
+void RenderTarget::draw_fullscreen() {
+	// Core profile requires a VAO to be bound even when no attributes are used
+	static UInt empty_VAO = 0;
+	if (!empty_VAO) { glGenVertexArrays(1, &empty_VAO); }
+
+	glBindVertexArray(empty_VAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+}
+
+void RenderTarget::create() {
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+	for (size_t iter = 0; iter < attachments.size(); ++iter) {
+		const RenderTargetAttachment& attachment = attachments.at(iter);
+
+		UInt texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, attachment.internal_format, width, height, 0, attachment.format, attachment.type, nullptr);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + static_cast<UInt>(iter), GL_TEXTURE_2D, texture, 0);
+		colour_textures.push_back(texture);
+	}
+
+	if (use_depth) {
+		glGenTextures(1, &depth_texture);
+		glBindTexture(GL_TEXTURE_2D, depth_texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture, 0);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	draw_to_all();
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		throw std::runtime_error("Render target framebuffer is not complete!");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderTarget::destroy() {
+	if (!colour_textures.empty()) {
+		glDeleteTextures(static_cast<int>(colour_textures.size()), &colour_textures[0]);
+		colour_textures.clear();
+	}
+
+	glDeleteTextures(1, &depth_texture);
+	glDeleteFramebuffers(1, &framebuffer);
+
+	depth_texture = 0;
+	framebuffer = 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "EngineHeader.hpp"
+
+
+struct RenderTargetAttachment {
+	UInt internal_format;	// e.g. GL_RGBA8, GL_RGBA16F
+	UInt format;			// e.g. GL_RGBA
+	UInt type;				// e.g. GL_UNSIGNED_BYTE, GL_FLOAT
+};
+
+class RenderTarget {
+	/*
+	Offscreen framebuffer with any number of colour textures and an optional depth texture
+
+	Colour attachment 'n' is always GL_COLOR_ATTACHMENT0 + n, so the fragment shader
+	output at location 'n' writes to it when all attachments are drawn to
+	*/
+
+public:
+	RenderTarget(const UInt& width, const UInt& height, const std::vector<RenderTargetAttachment>& colour_attachments, const bool use_depth = true);
+	~RenderTarget();
+
+	RenderTarget(const RenderTarget& other) = delete;
+	void operator=(const RenderTarget& other) = delete;
+
+	void resize(const UInt& new_width, const UInt& new_height);
+
+	// Binds the framebuffer and sets the viewport to cover it
+	void bind() const;
+	static void unbind();
+
+	// Selects which colour attachments fragment outputs are written to
+	void draw_to_all() const;
+	void draw_to(const std::vector<size_t>& attachment_indices) const;
+
+	void bind_colour_texture(const size_t& index, const UInt& texture_unit) const;
+	inline UInt get_colour_texture(const size_t& index) const { return colour_textures.at(index); }
+	inline UInt get_depth_texture() const { return depth_texture; }
+	inline UInt get_framebuffer() const { return framebuffer; }
+
+	inline UInt get_width() const { return width; }
+	inline UInt get_height() const { return height; }
+
+	// Draws a single triangle covering the screen, the vertex shader must generate positions from gl_VertexID
+	static void draw_fullscreen();
+
+private:
+	UInt framebuffer = 0;
+	UInt depth_texture = 0;
+	std::vector<UInt> colour_textures;
+	std::vector<RenderTargetAttachment> attachments;
+
+	UInt width;
+	UInt height;
+	bool use_depth;
+
+	void create();
+	void destroy();
+};
@@ -1,6 +1,14 @@
 #include "Renderable.hpp"
 
 Renderable::~Renderable(){
+	if (_buffer_range.is_allocated()) { BufferAllocator::get_instance().free(_buffer_range); }
 	glDeleteVertexArrays(1, &_VAO);
 	glDeleteBuffers(1, &_VBO);
 }
+
+bool Renderable::enable_blending() {
+	if (!is_transparent() || glIsEnabled(GL_BLEND)) { return false; }
+
+	glEnable(GL_BLEND);
+	return true;
+}
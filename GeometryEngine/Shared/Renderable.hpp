@@ -1,5 +1,5 @@
 #pragma once
-#include "EngineHeader.hpp"
+#include "BufferAllocator.hpp"
 
 class Renderable {
 public:
@@ -10,12 +10,22 @@ public:
 	virtual ~Renderable();
     virtual void render(const SHADER_ID& id = SHADER_ID()) = 0;
     virtual SHADER_ID get_identifier() = 0; // Used so that ResourceHandler knows which shaders to use for derived
+
+	// Transparent renderables need blending and are drawn after the opaque ones, back to front (see RenderQueue)
+	virtual bool is_transparent() { return false; }
     
 protected:
 	virtual void evaluate_changed() = 0;
 
+	// Blending is off by default, so transparent renderables drawn outside of a RenderQueue (menus) turn it on themselves
+	// Returns whether it was turned on, in which case it should be turned back off once drawn
+	bool enable_blending();
+
 	bool _needs_evaluation = true;
     
+	// Static geometry is suballocated from the shared buffers, only geometry rewritten every draw (text) has its own
+	BufferRange _buffer_range;
+
 	UInt _VAO = 0;
 	UInt _VBO = 0;
 };
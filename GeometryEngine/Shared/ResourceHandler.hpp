@@ -1,6 +1,8 @@
 #pragma once
 
 #include "LightMapProgram.hpp"
+#include "TransformFeedbackProgram.hpp"
+#include "ComputeProgram.hpp"
 #include "Shape.hpp"
 
 
@@ -28,6 +30,14 @@ public:
         _programs.insert({ id, new LightMapProgram(vertex, fragment, geo) });
 	}
 
+	inline void load_transform_feedback(const std::string& vertex, const std::vector<std::string>& varyings, const SHADER_ID& id) {
+		_programs.insert({ id, new TransformFeedbackProgram(vertex, varyings) });
+	}
+
+	inline void load_compute(const std::string& compute, const SHADER_ID& id) {
+		_programs.insert({ id, new ComputeProgram(compute) });
+	}
+
 	inline Program& get_program(const SHADER_ID& program_id) { return *_programs.at(program_id); }
     
     // Textures
@@ -41,6 +51,10 @@ public:
         
     inline UInt get_texture(const std::string& texture_id) { return _textures.at(texture_id); }
 
+	// Textures with any alpha below one, whatever is drawn with them is transparent
+	inline void mark_translucent(const UInt& texture_id) { _translucent_textures.insert(texture_id); }
+	inline bool is_translucent(const UInt& texture_id) const { return _translucent_textures.count(texture_id) != 0; }
+
 	ResourceHandler(const ResourceHandler& other) = delete;
 	void operator=(const ResourceHandler& other) = delete;
 
@@ -49,5 +63,6 @@ private:
     ~ResourceHandler();
 	std::map<SHADER_ID, Program*> _programs;
     std::map<std::string, UInt> _textures;
+	std::set<UInt> _translucent_textures;
 };
 
@@ -25,6 +25,7 @@ UInt Shape::load_texture_from_rgba(const float& red, const float& green, const f
 	glBindTexture(GL_TEXTURE_2D, 0);
     
     Shape::add_texture_to_resource_handler(colour.to_string(), texture_id);
+	if (alpha < 1.0f) { ResourceHandler::get_instance().mark_translucent(texture_id); }
 
     return ResourceHandler::get_instance().get_texture(colour.to_string());
 }
@@ -61,6 +62,15 @@ UInt Shape::load_texture_from_file(const std::string& path, const std::string& d
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// Decides whether whatever uses this texture is drawn in the transparent pass
+	for (int pixel = 0; image && (pixel < width * height); ++pixel) {
+		if (image[(pixel * 4) + 3] < 255) {
+			ResourceHandler::get_instance().mark_translucent(texture_id);
+			break;
+		}
+	}
+
 	SOIL_free_image_data(image);
 
     Shape::add_texture_to_resource_handler(file_name.c_str(), texture_id);
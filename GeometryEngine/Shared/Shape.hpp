@@ -25,6 +25,9 @@ public:
     }
     
     vec3 get_vertex_position(const size_t& index);
+
+	// Interleaved position, normal and texture coordinates, 8 floats per vertex
+	inline const std::vector<float>& get_vertex_data() const { return vertices; }
     
     
 protected:
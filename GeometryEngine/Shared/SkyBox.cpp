@@ -61,8 +61,8 @@ void SkyBox::render(const SHADER_ID& id){
     
     glCullFace(GL_FRONT);
     
-    glBindVertexArray(_VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    BufferAllocator::get_instance().bind(_buffer_range.format);
+    glDrawArrays(GL_TRIANGLES, _buffer_range.first_vertex, 36);
     glBindVertexArray(0);
     
     glCullFace(GL_BACK);
@@ -73,20 +73,8 @@ void SkyBox::render(const SHADER_ID& id){
 void SkyBox::evaluate_changed(){
     if (!_needs_evaluation) { return; }
     _needs_evaluation = false;
-    
-    glDeleteVertexArrays(1, &_VAO);
-    glDeleteBuffers(1, &_VBO);
-    
-    glGenVertexArrays(1, &_VAO);
-    glBindVertexArray(_VAO);
-    
-    glGenBuffers(1, &_VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * this->vertices.size(), &this->vertices[0], GL_STATIC_DRAW);
-    
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), nullptr);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+
+    BufferAllocator& allocator = BufferAllocator::get_instance();
+    allocator.free(_buffer_range);
+    _buffer_range = allocator.allocate(VertexFormats::STANDARD, &vertices[0], vertices.size() / 8);
 }
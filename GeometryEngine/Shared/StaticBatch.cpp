@@ -0,0 +1,192 @@
+#include "StaticBatch.hpp"
+
+
+StaticBatch::~StaticBatch() {
+	destroy();
+}
+
+void StaticBatch::add(Cube& cube) {
+	if (built) { throw std::runtime_error("Cannot add to a static batch once it has been built"); }
+
+	const std::vector<float>& data = cube.get_vertex_data();
+	std::vector<MeshVertex> vertices;
+	std::vector<UInt> indices;
+
+	for (size_t iter = 0; (iter + 7) < data.size(); iter += 8) {
+		vertices.push_back({
+			vec3(data.at(iter), data.at(iter + 1), data.at(iter + 2)),
+			vec3(data.at(iter + 3), data.at(iter + 4), data.at(iter + 5)),
+			vec2(data.at(iter + 6), data.at(iter + 7))
+		});
+
+		indices.push_back(static_cast<UInt>(indices.size()));
+	}
+
+	// Cubes sample their one texture for both maps
+	add_sub_mesh(get_batch(cube.get_texture(), cube.get_texture()), vertices, { indices }, cube);
+}
+
+void StaticBatch::add(Model& model) {
+	if (built) { throw std::runtime_error("Cannot add to a static batch once it has been built"); }
+
+	for (size_t mesh_iter = 0; mesh_iter < model.meshes.size(); ++mesh_iter) {
+		const Mesh& mesh = model.meshes.at(mesh_iter);
+
+		int diffuse_texture = mesh.find_texture("texture_diffuse");
+		int specular_texture = mesh.find_texture("texture_specular");
+
+		// One shared texture, so untextured meshes all fall into the same batch
+		if (diffuse_texture < 0) {
+			static const UInt debug_texture = Shape::load_texture_from_rgba(Colours::DEBUG_COLOUR);
+			diffuse_texture = static_cast<int>(debug_texture);
+		}
+		if (specular_texture < 0) { specular_texture = diffuse_texture; }
+
+		std::vector<std::vector<UInt>> lods = { mesh.get_indices() };
+		lods.insert(lods.end(), mesh.get_lods().begin(), mesh.get_lods().end());
+
+		// Meshes take their transform from the model when it is rendered, so the model's is used here
+		add_sub_mesh(get_batch(static_cast<UInt>(diffuse_texture), static_cast<UInt>(specular_texture)), mesh.get_vertices(), lods, model);
+	}
+}
+
+void StaticBatch::build() {
+	if (built) { return; }
+
+	BufferAllocator& allocator = BufferAllocator::get_instance();
+
+	for (size_t batch_iter = 0; batch_iter < batches.size(); ++batch_iter) {
+		Batch& batch = batches.at(batch_iter);
+		batch.buffer_range = allocator.allocate(VertexFormats::STANDARD, batch.vertices.data(), batch.vertices.size(), batch.indices.data(), batch.indices.size() * sizeof(UInt));
+
+		// The GPU has its copy, only the sub-mesh ranges and bounds are needed from here on
+		batch.vertices = std::vector<MeshVertex>();
+		batch.indices = std::vector<UInt>();
+	}
+
+	built = true;
+}
+
+void StaticBatch::render(const SHADER_ID& id, const Frustum* frustum) {
+	if (!built) { build(); }
+
+	Program& program = ResourceHandler::get_instance().get_program(id);
+	program.set_uniform<mat4>("model", EngineConstants::IDENTITY_MATRIX);
+	program.set_uniform<float>("material.shininess", 16.0f);
+	program.set_uniform<int>("material.texture_diffuse", 0);
+	program.set_uniform<int>("material.texture_specular", 1);
+
+	const bool use_lods = Model::has_lod_view();
+	const vec3 view_position = Model::get_lod_view_position();
+
+	std::vector<int> counts;
+	std::vector<void*> offsets;
+	std::vector<int> base_vertices;
+
+	BufferAllocator::get_instance().bind(VertexFormats::STANDARD);
+
+	for (size_t batch_iter = 0; batch_iter < batches.size(); ++batch_iter) {
+		Batch& batch = batches.at(batch_iter);
+		counts.clear();
+		offsets.clear();
+
+		const size_t index_offset = batch.buffer_range.index_offset;
+
+		for (size_t sub_mesh_iter = 0; sub_mesh_iter < batch.sub_meshes.size(); ++sub_mesh_iter) {
+			SubMesh& sub_mesh = batch.sub_meshes.at(sub_mesh_iter);
+			if (frustum && !frustum->intersects_aabb(sub_mesh.aabb_min, sub_mesh.aabb_max)) { continue; }
+
+			if (use_lods) {
+				const vec3 centre = (sub_mesh.aabb_min + sub_mesh.aabb_max) * 0.5f;
+				const float radius = length(sub_mesh.aabb_max - centre);
+				const float view_distance = distance(view_position, centre);
+
+				sub_mesh.current_lod = (view_distance <= radius) ? 0 :
+					Mesh::select_lod(sub_mesh.current_lod, sub_mesh.lod_ranges.size() - 1, (radius * Model::get_lod_projection_scale()) / view_distance);
+			}
+
+			const std::pair<size_t, size_t>& range = sub_mesh.lod_ranges.at(use_lods ? sub_mesh.current_lod : 0);
+
+			// Neighbouring ranges are joined, so a fully visible batch is a single range
+			if (!counts.empty() && (((reinterpret_cast<size_t>(offsets.back()) - index_offset) / sizeof(UInt)) + counts.back() == range.first)) {
+				counts.back() += static_cast<int>(range.second);
+				continue;
+			}
+
+			counts.push_back(static_cast<int>(range.second));
+			offsets.push_back(reinterpret_cast<void*>(index_offset + (range.first * sizeof(UInt))));
+		}
+
+		if (counts.empty()) { continue; }
+		base_vertices.assign(counts.size(), static_cast<int>(batch.buffer_range.first_vertex));
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, batch.diffuse_texture);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, batch.specular_texture);
+
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, &counts[0], GL_UNSIGNED_INT, &offsets[0], static_cast<int>(counts.size()), &base_vertices[0]);
+	}
+
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+StaticBatch::Batch& StaticBatch::get_batch(const UInt& diffuse_texture, const UInt& specular_texture) {
+	for (size_t iter = 0; iter < batches.size(); ++iter) {
+		Batch& batch = batches.at(iter);
+		if ((batch.diffuse_texture == diffuse_texture) && (batch.specular_texture == specular_texture)) { return batch; }
+	}
+
+	batches.push_back({ diffuse_texture, specular_texture, {}, {}, {}, BufferRange() });
+	return batches.back();
+}
+
+void StaticBatch::add_sub_mesh(Batch& batch, const std::vector<MeshVertex>& vertices, const std::vector<std::vector<UInt>>& lods, Transformable& transform) {
+	if (vertices.empty()) { return; }
+
+	const mat4 model_matrix = transform.get_model_matrix();
+	const quat rotation = transform.get_quaternion();
+	const vec3 enlargement = transform.get_enlargement();
+	const UInt first_vertex = static_cast<UInt>(batch.vertices.size());
+
+	SubMesh sub_mesh;
+	sub_mesh.current_lod = 0;
+
+	for (size_t iter = 0; iter < vertices.size(); ++iter) {
+		MeshVertex vertex = vertices.at(iter);
+		vec4 position(vertex.position, 1.0f);
+		vertex.position = to_vec3(model_matrix * position);
+
+		// Inverse scale then rotate, the inverse transpose of a rotation and scale
+		const vec3 scaled_normal(vertex.normal.x / enlargement.x, vertex.normal.y / enlargement.y, vertex.normal.z / enlargement.z);
+		if (length_squared(scaled_normal) > 0.0f) { vertex.normal = normalise(rotation * scaled_normal); }
+
+		if (iter == 0) {
+			sub_mesh.aabb_min = vertex.position;
+			sub_mesh.aabb_max = vertex.position;
+		}
+
+		sub_mesh.aabb_min = vec3(std::min(sub_mesh.aabb_min.x, vertex.position.x), std::min(sub_mesh.aabb_min.y, vertex.position.y), std::min(sub_mesh.aabb_min.z, vertex.position.z));
+		sub_mesh.aabb_max = vec3(std::max(sub_mesh.aabb_max.x, vertex.position.x), std::max(sub_mesh.aabb_max.y, vertex.position.y), std::max(sub_mesh.aabb_max.z, vertex.position.z));
+
+		batch.vertices.push_back(vertex);
+	}
+
+	for (size_t lod_iter = 0; lod_iter < lods.size(); ++lod_iter) {
+		const std::vector<UInt>& lod = lods.at(lod_iter);
+		sub_mesh.lod_ranges.push_back(std::make_pair(batch.indices.size(), lod.size()));
+
+		for (size_t iter = 0; iter < lod.size(); ++iter) { batch.indices.push_back(first_vertex + lod.at(iter)); }
+	}
+
+	batch.sub_meshes.push_back(sub_mesh);
+}
+
+void StaticBatch::destroy() {
+	for (size_t iter = 0; iter < batches.size(); ++iter) {
+		BufferAllocator::get_instance().free(batches.at(iter).buffer_range);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "Model.hpp"
+#include "Cube.hpp"
+#include "Frustum.hpp"
+
+
+class StaticBatch {
+	/*
+	Merges geometry that never moves into one range of the shared buffers per material
+
+	Sources are added with their current transform, which is baked into the vertices, then build()
+	uploads every material's vertices and indices once. Each source mesh is kept as a sub-mesh
+	with its own world space bounds (and levels of detail, for models) so that it can still be
+	culled and simplified on its own. Visible sub-meshes of a material are drawn together with a
+	single glMultiDrawElementsBaseVertex, every batch through the same VAO.
+
+	Sources are copied, changes made to them after being added are not reflected
+	*/
+
+public:
+	StaticBatch() {}
+	~StaticBatch();
+
+	StaticBatch(const StaticBatch& other) = delete;
+	void operator=(const StaticBatch& other) = delete;
+
+	void add(Cube& cube);
+	void add(Model& model);
+	void build();
+
+	// Sub-meshes outside the frustum are skipped, none are when no frustum is given
+	void render(const SHADER_ID& id, const Frustum* frustum = nullptr);
+
+	inline size_t get_batch_count() const { return batches.size(); }
+
+private:
+	struct SubMesh {
+		vec3 aabb_min;
+		vec3 aabb_max;
+		std::vector<std::pair<size_t, size_t>> lod_ranges;	// Offset and count within the batch's indices, LOD 0 first
+		size_t current_lod;
+	};
+
+	struct Batch {
+		UInt diffuse_texture;
+		UInt specular_texture;
+
+		std::vector<MeshVertex> vertices;
+		std::vector<UInt> indices;
+		std::vector<SubMesh> sub_meshes;
+
+		BufferRange buffer_range;
+	};
+
+	std::vector<Batch> batches;
+	bool built = false;
+
+	Batch& get_batch(const UInt& diffuse_texture, const UInt& specular_texture);
+	void add_sub_mesh(Batch& batch, const std::vector<MeshVertex>& vertices, const std::vector<std::vector<UInt>>& lods, Transformable& transform);
+	void destroy();
+};
@@ -93,6 +93,8 @@ void Text::render(const SHADER_ID& id) {
 	text_program.set_uniform<mat4>("model", get_model_matrix());
     text_program.set_uniform<vec3>("text_colour", vec3(colour.red, colour.green, colour.blue));
 
+	const bool blending_enabled = enable_blending();
+
 	glActiveTexture(GL_TEXTURE0);
 	glBindVertexArray(_VAO);
 
@@ -133,6 +135,8 @@ void Text::render(const SHADER_ID& id) {
     
 	glBindVertexArray(0);
 	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (blending_enabled) { glDisable(GL_BLEND); }
 }
 
 void Text::evaluate_changed() {
@@ -15,6 +15,7 @@ class Text : public Shape {
 public:
     inline static SHADER_ID GENERIC_ID() { return "Text"; };
     virtual inline SHADER_ID get_identifier(){ return Text::GENERIC_ID(); }
+	virtual inline bool is_transparent() { return true; }	// Glyphs are coverage masks
     
 	Text(const std::string& font_path, const std::string& text = "Default Text");
     Text(const Text& other);
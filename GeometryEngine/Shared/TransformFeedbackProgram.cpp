@@ -0,0 +1,25 @@
+#include "TransformFeedbackProgram.hpp"
+
+
+TransformFeedbackProgram::TransformFeedbackProgram(const std::string& vertex_shader_path, const std::vector<std::string>& varyings) : Program() {
+	if (!boost::filesystem::exists(vertex_shader_path)) { throw std::runtime_error(vertex_shader_path + " does not exist"); }
+
+	std::ifstream vertex_file_stream(vertex_shader_path);
+	const std::string vertex_file_string((std::istreambuf_iterator<char>(vertex_file_stream)), std::istreambuf_iterator<char>());
+
+	const UInt vertex_id = _compile_shader_string(GL_VERTEX_SHADER, vertex_file_string);
+	const UInt program_id = glCreateProgram();
+	glAttachShader(program_id, vertex_id);
+
+	// Varyings must be declared before linking
+	std::vector<const char*> raw_varyings;
+	for (size_t iter = 0; iter < varyings.size(); ++iter) {
+		raw_varyings.push_back(varyings.at(iter).c_str());
+	}
+
+	glTransformFeedbackVaryings(program_id, static_cast<int>(raw_varyings.size()), &raw_varyings[0], GL_INTERLEAVED_ATTRIBS);
+	glLinkProgram(program_id);
+	check_link_status(program_id);
+
+	_program_id = program_id;
+}
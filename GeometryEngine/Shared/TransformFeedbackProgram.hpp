@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Program.hpp"
+
+
+class TransformFeedbackProgram : public Program {
+	/*
+	Vertex-only program whose outputs are captured into buffers instead of being rasterised
+
+	The named varyings are captured interleaved, in the order given, so they must
+	match the attribute layout of the buffer they are written to
+	*/
+
+public:
+	TransformFeedbackProgram(const TransformFeedbackProgram& other) = delete;
+	void operator=(const TransformFeedbackProgram& other) = delete;
+
+	TransformFeedbackProgram(const std::string& vertex_shader_path, const std::vector<std::string>& varyings);
+	virtual ~TransformFeedbackProgram() {}
+};
@@ -0,0 +1,48 @@
+#include "AIScheduler.hpp"
+#include <chrono>
+
+
+AIScheduler::AIScheduler(const float& budget_microseconds) : budget(budget_microseconds) {}
+
+void AIScheduler::request(Enemy* enemy) {
+	if (!is_queued(enemy)) { queue.push_back(enemy); }
+}
+
+void AIScheduler::cancel(Enemy* enemy) {
+	queue.erase(std::remove(queue.begin(), queue.end(), enemy), queue.end());
+}
+
+void AIScheduler::clear() {
+	queue.clear();
+	debt = 0.0f;
+}
+
+void AIScheduler::run(const std::function<float(Enemy*)>& priority, const std::function<void(Enemy*)>& work) {
+	const float allowance = budget - debt;
+	last_spent = 0.0f;
+
+	if (queue.empty() || (allowance <= 0.0f)) {
+		debt = std::max(-allowance, 0.0f);
+		return;
+	}
+
+	ordered.clear();
+	for (size_t iter = 0; iter < queue.size(); ++iter) { ordered.push_back(std::make_pair(priority(queue[iter]), queue[iter])); }
+
+	std::sort(ordered.begin(), ordered.end(), [](const std::pair<float, Enemy*>& left, const std::pair<float, Enemy*>& right) { return left.first < right.first; });
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size_t finished = 0;
+
+	// The budget is checked between tasks, so the last one run can overrun it
+	while ((finished < ordered.size()) && (last_spent < allowance)) {
+		work(ordered[finished].second);
+		++finished;
+
+		last_spent = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	for (size_t iter = 0; iter < finished; ++iter) { cancel(ordered[iter].second); }
+
+	debt = std::max(last_spent - allowance, 0.0f);
+}
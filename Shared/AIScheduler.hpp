@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Enemy.hpp"
+#include <functional>
+
+
+class AIScheduler {
+	/*
+	Spreads enemies' expensive thinking, such as searching for a new path, across frames
+
+	Enemies are queued when they need to think and run() works through the queue nearest the
+	player first (or by whatever priority it is given), stopping once the frame's budget is
+	spent. Whatever is left waits for the next frame. A frame that overruns its budget has the
+	excess taken from the frames after it, so a slow search is paid back rather than repeated.
+	Time left over is not saved up, an idle frame never pays for a burst later on
+
+	Each enemy is queued at most once, and must be cancelled before it is deleted
+	*/
+
+public:
+	AIScheduler(const float& budget_microseconds);
+
+	AIScheduler(const AIScheduler& other) = delete;
+	void operator=(const AIScheduler& other) = delete;
+
+	// Ignored if the enemy is already queued
+	void request(Enemy* enemy);
+	void cancel(Enemy* enemy);
+	void clear();
+
+	// Lower priorities run first, they are found afresh every frame as enemies move
+	void run(const std::function<float(Enemy*)>& priority, const std::function<void(Enemy*)>& work);
+
+	inline bool is_queued(Enemy* enemy) const { return std::find(queue.begin(), queue.end(), enemy) != queue.end(); }
+	inline size_t get_queued_count() const { return queue.size(); }
+	inline float get_last_spent() const { return last_spent; }		// Microseconds run() took last frame
+	inline float get_debt() const { return debt; }
+
+private:
+	float budget;
+	float debt = 0.0f;
+	float last_spent = 0.0f;
+
+	std::vector<Enemy*> queue;
+	std::vector<std::pair<float, Enemy*>> ordered;
+};
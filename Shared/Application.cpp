@@ -3,11 +3,17 @@
 #include "Shape.hpp"
 #include "SkyBox.hpp"
 #include "Text.hpp"
+#include "DeferredRenderer.hpp"
+#include "ParticleSystem.hpp"
+#include "Impostor.hpp"
+#include "IndirectRenderer.hpp"
+#include "PostProcess.hpp"
 
 #include "OptionsScene.hpp"
 #include "LoadingScene.hpp"
 #include "InstructionsScene.hpp"
 #include "DeathScene.hpp"
+#include "CalibrationScene.hpp"
 
 
 Application::Application() {
@@ -19,6 +25,10 @@ Application::Application() {
 	}
 
 	if (parser.get_attribute(Options::SHADOWS) == "") { parser.add_attribute(Options::SHADOWS, "On"); }
+	if (parser.get_attribute(Options::DEPTH_PREPASS) == "") { parser.add_attribute(Options::DEPTH_PREPASS, "Off"); }
+	if (parser.get_attribute(Options::RENDER_PATH) == "") { parser.add_attribute(Options::RENDER_PATH, "Forward"); }
+	if (parser.get_attribute(Options::ANTI_ALIASING) == "") { parser.add_attribute(Options::ANTI_ALIASING, "Off"); }
+	if (parser.get_attribute(Options::NAVIGATION) == "") { parser.add_attribute(Options::NAVIGATION, "FlowField"); }
 
 	// Setting up rendering
 	if (!glfwInit()) {
@@ -53,7 +63,7 @@ Application::Application() {
 	glEnable(GL_MULTISAMPLE); // If wanting to uncomment, change window hint too!
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_CULL_FACE);	// Disables drawing of all sides (front / back)
-	glEnable(GL_BLEND);
+	// Blending stays off for opaque geometry, transparent draws turn it on (see RenderQueue)
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glDepthFunc(GL_LESS);
@@ -69,6 +79,49 @@ Application::Application() {
                           FileSystem::get_shader("shadow_frag.shader").string(),
                           FileSystem::get_shader("shadow_geometry.shader").string(),
                           "Shadow");
+
+	instance.load_program(FileSystem::get_shader("depth_prepass_vertex.shader").string(),
+						  FileSystem::get_shader("depth_prepass_frag.shader").string(),
+						  "DepthPrePass");
+
+	instance.load_program(FileSystem::get_shader("deferred_geometry_vertex.shader").string(),
+						  FileSystem::get_shader("deferred_geometry_frag.shader").string(),
+						  DeferredRenderer::GEOMETRY_ID());
+
+	// Built from the same feature sets as the forward program, so it follows its shadow quality tier
+	instance.load_lightmap(FileSystem::get_shader("deferred_light_vertex.shader").string(),
+						   FileSystem::get_shader("deferred_light_frag.shader").string(),
+						   DeferredRenderer::LIGHTING_ID());
+
+	instance.load_program(FileSystem::get_shader("deferred_composite_vertex.shader").string(),
+						  FileSystem::get_shader("deferred_composite_frag.shader").string(),
+						  DeferredRenderer::COMPOSITE_ID());
+
+	// Same full screen triangle as the composite, upscaling without anti-aliasing is a plain copy like it
+	instance.load_program(FileSystem::get_shader("deferred_composite_vertex.shader").string(),
+						  FileSystem::get_shader("fxaa_frag.shader").string(),
+						  PostProcess::FXAA_ID());
+
+	instance.load_program(FileSystem::get_shader("deferred_composite_vertex.shader").string(),
+						  FileSystem::get_shader("deferred_composite_frag.shader").string(),
+						  PostProcess::UPSCALE_ID());
+
+	instance.load_transform_feedback(FileSystem::get_shader("particle_update_vertex.shader").string(),
+									 { "out_position_life", "out_velocity_start_life" },
+									 ParticleSystem::UPDATE_ID());
+
+	instance.load_program(FileSystem::get_shader("particle_vertex.shader").string(),
+						  FileSystem::get_shader("particle_frag.shader").string(),
+						  ParticleSystem::RENDER_ID());
+
+	instance.load_program(FileSystem::get_shader("impostor_vertex.shader").string(),
+						  FileSystem::get_shader("impostor_frag.shader").string(),
+						  Impostor::GENERIC_ID());
+
+	// Compute shaders need a 4.3 context, without one enemies are drawn one at a time
+	if (IndirectRenderer::is_supported()) {
+		instance.load_compute(FileSystem::get_shader("indirect_cull_compute.shader").string(), IndirectRenderer::CULL_ID());
+	}
     
     instance.load_program(FileSystem::get_shader("skybox_vertex.shader").string(),
                           FileSystem::get_shader("skybox_frag.shader").string(),
@@ -125,6 +178,14 @@ EnumType Application::options_scene() {
 	return return_code;
 }
 
+EnumType Application::calibration_scene() {
+	CalibrationScene* calibration_scene = CalibrationScene::get_instance(window, camera);
+	EnumType return_code = calibration_scene->main_loop();
+	CalibrationScene::delete_instance();
+
+	return return_code;
+}
+
 EnumType Application::death_scene(const UInt& score) {
     DeathScene* death_scene = DeathScene::get_instance(window, camera);
     death_scene->set_score(score);
@@ -187,10 +248,33 @@ void Application::run_options_scene() {
 			break;
 		}
 
+		case (OptionsReturnCodes::CALIBRATE) : {
+			if (calibration_scene() == CalibrationReturnCodes::EXIT_GAME) { return; }
+			run_options_scene();
+			break;
+		}
+
 		default: { throw std::runtime_error("Non-standard options return code (this should never be output)"); }
 	}
 }
 
+void Application::run_calibration_scene() {
+	EnumType calibration_return_code = calibration_scene();
+
+	switch (calibration_return_code) {
+		case (CalibrationReturnCodes::EXIT_GAME) : {
+			return;
+		}
+
+		case (CalibrationReturnCodes::FINISHED) : {
+			run_main_menu();
+			break;
+		}
+
+		default: { throw std::runtime_error("Non-standard calibration return code (this should never be output)"); }
+	}
+}
+
 void Application::run_death_scene(const UInt& score) {
     EnumType death_return_code = death_scene(score);
     
@@ -204,5 +288,9 @@ void Application::run_death_scene(const UInt& score) {
 
 void Application::start() {
     InstructionsScene::get_instance().main_loop();
-    run_main_menu();
+
+	// The first launch picks its options from a short benchmark, later ones go straight to the menu
+	AttributeParser parser(GameConstants::OPTIONS());
+	if (parser.get_attribute(Options::CALIBRATED) == "") { run_calibration_scene(); }
+	else { run_main_menu(); }
 }
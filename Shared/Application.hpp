@@ -20,11 +20,13 @@ public:
 	EnumType main_menu();
     std::pair<EnumType, UInt> game_scene();
 	EnumType options_scene();
+	EnumType calibration_scene();
     EnumType death_scene(const UInt& score);
 
 	void run_main_menu();
     void run_game_scene();
 	void run_options_scene();
+	void run_calibration_scene();
     void run_death_scene(const UInt& score);
     
 private:
@@ -0,0 +1,396 @@
+#include "CalibrationScene.hpp"
+#include "ResourceHandler.hpp"
+#include "GameHelpers.hpp"
+#include "Shape.hpp"
+#include "Camera.hpp"
+#include "AttributeParser.hpp"
+#include "Frustum.hpp"
+#include "Enemy.hpp"
+
+CalibrationScene* CalibrationScene::instance = nullptr;
+
+
+CalibrationScene::CalibrationScene(WindowWrapper* window, Camera* camera) : BaseScene(window, camera),
+terrain(FileSystem::get_mesh("Scene/ORIGINAL.obj").string()),
+enemy_model(Enemy::MODEL_PATH()),
+health_text(GameConstants::MECHA(), "100"),
+title(GameConstants::MECHA(), "Calibrating"),
+progress(GameConstants::ARIAL(), ""),
+post_process(window->width(), window->height()),
+presets(get_presets()) {
+
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+	if (light_program) { light_program->reset(); }
+
+	bind_callbacks();
+	init();
+	setup_framebuffer();
+
+	std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
+	mat4 text_vp = ortho(0.0f, static_cast<float>(window_dimensions.first), 0.0f, static_cast<float>(window_dimensions.second));
+	ResourceHandler& instance = ResourceHandler::get_instance();
+	instance.get_program(Text::GENERIC_ID()).set_uniform<mat4>("VP", text_vp);
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<float>("far_plane", GameConstants::far_plane);
+	if (light_program) { light_program->set_feature(LightMapFeatures::LIGHT_COLOUR, true); }
+
+	terrain_batch.add(terrain);
+	terrain_batch.build();
+
+	prepare_preset();
+}
+
+CalibrationScene::~CalibrationScene() {
+	destroy_multisample_target();
+
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteTextures(1, &cube_map);
+}
+
+void CalibrationScene::bind_callbacks(){
+    GLFWwindow* window = this->window->get_window();
+	glfwSetWindowCloseCallback(window, CalibrationScene::WINDOW_CLOSE_HELPER);
+}
+
+int CalibrationScene::main_loop(){
+	while (return_code == ReturnCodes::DEFAULT){
+		pre_render();
+        render();
+		post_render();
+
+		if (is_finished() && ((static_cast<float>(glfwGetTime()) - finish_time) >= result_display_time)) {
+			return_code = CalibrationReturnCodes::FINISHED;
+		}
+    }
+
+	return return_code;
+}
+
+void CalibrationScene::pre_render(){
+	check_errors("Main Loop Pre-Render");
+
+    float current_frame_time = static_cast<float>(glfwGetTime());
+    frame_time_delta = current_frame_time - last_frame_time;
+    last_frame_time = current_frame_time;
+
+	glfwPollEvents();
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+	// The shadow pass is part of what is being measured
+	if (!is_finished()) {
+		frame_timer.begin_frame();
+
+		const bool use_shadows = presets.at(current_preset).shadows;
+		LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+		light_program->set_feature(LightMapFeatures::SHADOWS, use_shadows);
+
+		if (use_shadows) {
+			glActiveTexture(GL_TEXTURE31);
+			glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
+			ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_persistent_uniform<int>("depth_map", 31);
+
+			render_framebuffer();
+		}
+	}
+
+	std::pair<UShort, UShort> window_dimensions = window->get_window_dimensions();
+	glViewport(0, 0, window_dimensions.first, window_dimensions.second);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void CalibrationScene::render(){
+	if (!is_finished()) {
+		render_benchmark(presets.at(current_preset));
+		frame_timer.end_frame();
+		record_frame();
+	}
+
+	// Text is rendered orthogonally by default
+	dynamic_cast<Renderable*>(&title)->render();
+	dynamic_cast<Renderable*>(&progress)->render();
+}
+
+// Member Functions
+void CalibrationScene::init(){
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+
+	PointLight* praise_the_sun = new PointLight {
+		vec3(0.0f, 25.0f, 0.0f),
+		vec3(0.8f),
+		1.0f,
+		0.01f,
+		0.0f,
+		vec3(1.0f),
+		vec3(1.0f),
+		vec3(0.4f)
+	};
+
+	light_program->add_light(praise_the_sun);
+
+	// Two rings of enemies, about as many as a late wave puts on screen
+	for (UInt enemy_iter = 0; enemy_iter < enemy_count; ++enemy_iter) {
+		const float ring_radius = (enemy_iter % 2 == 0) ? 12.0f : 22.0f;
+		const float angle = (2.0f * 3.14159265f * enemy_iter) / enemy_count;
+		enemy_positions.push_back(vec3(std::cos(angle) * ring_radius, 2.0f, std::sin(angle) * ring_radius));
+	}
+
+	health_text.set_scale(0.01f);
+	health_text.set_colour(Colours::GREEN);
+	health_text.set_horisontal_align();
+
+	std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
+	vec3 orthogonal_screen_centre(window_dimensions.first / 2.0f, window_dimensions.second / 2.0f, 0.0f);
+
+	title.set_colour(Colours::CRIMSON);
+	title.set_scale(0.5f);
+	title.set_to_center();
+	title.set_position(vec3(orthogonal_screen_centre.x, orthogonal_screen_centre.y * 1.5f, 0.0f));
+
+	progress.set_colour(Colours::WHITE);
+	progress.set_scale(0.2f);
+	progress.set_position(vec3(orthogonal_screen_centre.x, orthogonal_screen_centre.y * (2.0f / 3.0f), 0.0f));
+
+	// The monitor's refresh rate is the frame time to beat, 60Hz when it cannot be read
+	const GLFWvidmode* video_mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	const int refresh_rate = (video_mode && (video_mode->refreshRate > 0)) ? video_mode->refreshRate : 60;
+	target_frame_time = (1000.0f / static_cast<float>(refresh_rate)) * frame_time_headroom;
+}
+
+void CalibrationScene::setup_framebuffer() {
+	glGenFramebuffers(1, &framebuffer);
+	glGenTextures(1, &cube_map);
+
+	glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
+	for (size_t face_iter = 0; face_iter < 6; ++face_iter) {
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<unsigned int>(face_iter),
+                     0,
+                     GL_DEPTH_COMPONENT,
+                     GameConstants::framebuffer_depth_resolution,
+                     GameConstants::framebuffer_depth_resolution,
+                     0,
+                     GL_DEPTH_COMPONENT,
+                     GL_FLOAT,
+                     nullptr);
+	}
+
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, cube_map, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		throw std::runtime_error("Framebuffer is not complete!");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void CalibrationScene::render_framebuffer() {
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+	const vec3 light_position = light_program->get_light(0)->position;
+
+	const std::vector<mat4> shadow_transforms = {
+		GameConstants::shadow_proj * look_at(light_position, light_position + vec3(1.0, 0.0, 0.0), vec3(0.0, -1.0, 0.0)),
+		GameConstants::shadow_proj * look_at(light_position, light_position + vec3(-1.0, 0.0, 0.0), vec3(0.0, -1.0, 0.0)),
+		GameConstants::shadow_proj * look_at(light_position, light_position + vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, 1.0)),
+		GameConstants::shadow_proj * look_at(light_position, light_position + vec3(0.0, -1.0, 0.0), vec3(0.0, 0.0, -1.0)),
+		GameConstants::shadow_proj * look_at(light_position, light_position + vec3(0.0, 0.0, 1.0), vec3(0.0, -1.0, 0.0)),
+		GameConstants::shadow_proj * look_at(light_position, light_position + vec3(0.0, 0.0, -1.0), vec3(0.0, -1.0, 0.0))
+	};
+
+	// Render scene to depth cubemap
+	Program& depth_shader = ResourceHandler::get_instance().get_program("Shadow");
+
+	glViewport(0, 0, GameConstants::framebuffer_depth_resolution, GameConstants::framebuffer_depth_resolution);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	for (size_t matrix_iter = 0; matrix_iter < shadow_transforms.size(); ++matrix_iter) {
+		depth_shader.set_uniform<mat4>("shadow_matrices[" + std::to_string(matrix_iter) + "]", shadow_transforms.at(matrix_iter));
+	}
+
+	depth_shader.set_uniform<float>("far_plane", GameConstants::far_plane);
+	depth_shader.set_uniform<vec3>("light_position", light_position);
+
+	terrain_batch.render("Shadow");
+
+	for (size_t enemy_iter = 0; enemy_iter < enemy_positions.size(); ++enemy_iter) {
+		enemy_model.set_position(enemy_positions.at(enemy_iter));
+		enemy_model.render("Shadow");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void CalibrationScene::prepare_preset() {
+	frame = 0;
+	measured_time = 0.0f;
+
+	const CalibrationPreset& preset = presets.at(current_preset);
+	destroy_multisample_target();
+	if (preset.multisampling > 0) { setup_multisample_target(preset.multisampling); }
+
+	progress.set_text("Testing settings " + std::to_string(current_preset + 1) + " of " + std::to_string(presets.size()));
+	progress.set_to_center();
+}
+
+void CalibrationScene::setup_multisample_target(const int& samples) {
+	const std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
+
+	glGenFramebuffers(1, &multisample_framebuffer);
+	glGenRenderbuffers(1, &multisample_colour);
+	glGenRenderbuffers(1, &multisample_depth);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, multisample_colour);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, window_dimensions.first, window_dimensions.second);
+	glBindRenderbuffer(GL_RENDERBUFFER, multisample_depth);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, window_dimensions.first, window_dimensions.second);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, multisample_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, multisample_colour);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, multisample_depth);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		throw std::runtime_error("Multisampled framebuffer is not complete!");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void CalibrationScene::destroy_multisample_target() {
+	if (!multisample_framebuffer) { return; }
+
+	glDeleteFramebuffers(1, &multisample_framebuffer);
+	glDeleteRenderbuffers(1, &multisample_colour);
+	glDeleteRenderbuffers(1, &multisample_depth);
+
+	multisample_framebuffer = 0;
+	multisample_colour = 0;
+	multisample_depth = 0;
+}
+
+void CalibrationScene::render_benchmark(const CalibrationPreset& preset) {
+	const std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
+	const float aspect_ratio = static_cast<float>(window_dimensions.first) / static_cast<float>(window_dimensions.second);
+
+	// The camera circles the arena so every preset sees the same mix of near and far geometry
+	const float angle = static_cast<float>(glfwGetTime()) * 0.3f;
+	const vec3 view_position(std::cos(angle) * 35.0f, 12.0f, std::sin(angle) * 35.0f);
+	camera->set_position(view_position);
+
+	const mat4 view_matrix = look_at(view_position, vec3(0.0f), vec3(0.0f, 1.0f, 0.0f));
+	const mat4 vp = perspective(GameConstants::FOV, aspect_ratio, GameConstants::near_plane, GameConstants::far_plane) * view_matrix;
+	const Frustum view_frustum(vp);
+
+	ResourceHandler& instance = ResourceHandler::get_instance();
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<mat4>("VP", vp);
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<vec3>("view_position", view_position);
+	instance.get_program("3DText").set_uniform<mat4>("VP", vp);
+
+	// Every preset is drawn offscreen, so each pays for the same final copy to the window
+	post_process.begin(window_dimensions.first, window_dimensions.second);
+
+	if (multisample_framebuffer) {
+		glBindFramebuffer(GL_FRAMEBUFFER, multisample_framebuffer);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+
+	terrain_batch.render(Shape::GENERIC_ID(), &view_frustum);
+
+	for (size_t enemy_iter = 0; enemy_iter < enemy_positions.size(); ++enemy_iter) {
+		enemy_model.set_position(enemy_positions.at(enemy_iter));
+		enemy_model.render(Shape::GENERIC_ID());
+	}
+
+	for (size_t enemy_iter = 0; enemy_iter < enemy_positions.size(); ++enemy_iter) {
+		health_text.set_position(enemy_positions.at(enemy_iter) + vec3(0.0f, 1.0f, 0.0f));
+		health_text.render("3DText");
+	}
+
+	// Resolves the samples into the post-process target
+	if (multisample_framebuffer) {
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, multisample_framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, post_process.get_target().get_framebuffer());
+		glBlitFramebuffer(0, 0, window_dimensions.first, window_dimensions.second, 0, 0, window_dimensions.first, window_dimensions.second, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
+
+	post_process.end(window_dimensions.first, window_dimensions.second, preset.fxaa);
+}
+
+void CalibrationScene::record_frame() {
+	++frame;
+	if (frame <= warm_up_frames) { return; }
+
+	// Whichever side is slower sets the frame rate
+	measured_time += std::max(frame_timer.get_cpu_time(), frame_timer.get_gpu_time());
+	if (frame < (warm_up_frames + measured_frames)) { return; }
+
+	const float average_time = measured_time / static_cast<float>(measured_frames);
+	const bool is_last_preset = (current_preset + 1) == presets.size();
+
+	// Presets run from best looking to cheapest, so the first that fits is kept
+	if ((average_time <= target_frame_time) || is_last_preset) {
+		const CalibrationPreset& preset = presets.at(current_preset);
+		save_preset(preset);
+
+		std::stringstream result;
+		result << "Multisampling x" << preset.multisampling
+			   << " | Shadows " << (preset.shadows ? "On" : "Off")
+			   << " | Anti-Aliasing " << (preset.fxaa ? "FXAA" : "Off")
+			   << (preset.multisampling > 0 ? " (multisampling applies after a restart)" : "");
+
+		title.set_text("Calibrated");
+		title.set_to_center();
+		progress.set_text(result.str());
+		progress.set_to_center();
+
+		current_preset = presets.size();
+		finish_time = static_cast<float>(glfwGetTime());
+		destroy_multisample_target();
+		return;
+	}
+
+	++current_preset;
+	prepare_preset();
+}
+
+void CalibrationScene::save_preset(const CalibrationPreset& preset) {
+	AttributeParser parser(GameConstants::OPTIONS());
+	parser.change_attribute(Options::MULTISAMPLING, std::to_string(preset.multisampling));
+	parser.change_attribute(Options::SHADOWS, preset.shadows ? "On" : "Off");
+	parser.change_attribute(Options::ANTI_ALIASING, preset.fxaa ? "FXAA" : "Off");
+	parser.change_attribute(Options::CALIBRATED, "On");
+}
+
+std::vector<CalibrationPreset> CalibrationScene::get_presets() {
+	const std::vector<CalibrationPreset> candidates = {
+		{ 8,	true,	false },
+		{ 4,	true,	false },
+		{ 2,	true,	false },
+		{ 0,	true,	true },
+		{ 0,	false,	true },
+		{ 0,	false,	false }
+	};
+
+	int max_samples = 0;
+	glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+
+	// Sample counts the driver cannot provide are clamped, which can leave repeats to skip
+	std::vector<CalibrationPreset> presets;
+	for (size_t iter = 0; iter < candidates.size(); ++iter) {
+		CalibrationPreset preset = candidates.at(iter);
+		preset.multisampling = std::min(preset.multisampling, max_samples);
+
+		const bool is_repeat = !presets.empty() && (presets.back().multisampling == preset.multisampling) &&
+							   (presets.back().shadows == preset.shadows) && (presets.back().fxaa == preset.fxaa);
+		if (!is_repeat) { presets.push_back(preset); }
+	}
+
+	return presets;
+}
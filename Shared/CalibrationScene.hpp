@@ -0,0 +1,127 @@
+#pragma once
+#include "BaseScene.hpp"
+#include "Model.hpp"
+#include "StaticBatch.hpp"
+#include "Text.hpp"
+#include "WindowWrapper.hpp"
+#include "PostProcess.hpp"
+#include "FrameTimer.hpp"
+
+
+struct CalibrationPreset {
+	int multisampling;
+	bool shadows;
+	bool fxaa;
+};
+
+
+class CalibrationReturnCodes : public ReturnCodes {
+public:
+	static const EnumType FINISHED = 9;
+};
+
+
+class CalibrationScene : public BaseScene {
+	/*
+	Picks the graphics options for this machine by rendering a short benchmark
+
+	A representative scene (the terrain and a wave of enemies with their health text, lit with
+	shadows) is drawn with each preset in turn, best looking first. The first preset whose frame
+	time fits the monitor's refresh rate is saved to OPTIONS, or the cheapest if none do.
+
+	The window's own samples are fixed when it is created, so multisampling is measured with an
+	offscreen multisampled target and a new rate only reaches the window after a restart
+	*/
+
+private:
+	// Const variables
+	const UInt warm_up_frames = 30;		// Lets shader variants compile and the smoothed timings settle
+	const UInt measured_frames = 90;
+	const UInt enemy_count = 30;
+	const float frame_time_headroom = 0.8f;	// Late waves are busier than the benchmark
+	const float result_display_time = 3.0f;
+
+public:
+    // Constructors and Destructors
+	CalibrationScene(WindowWrapper* window, Camera* camera);
+	virtual ~CalibrationScene();
+
+    // Deleted Versions
+	CalibrationScene(const CalibrationScene& other) = delete;
+    void operator=(const CalibrationScene& other) = delete;
+
+    // Instance Management
+	static CalibrationScene* get_instance(WindowWrapper* window = nullptr, Camera* camera = nullptr){
+		if (!CalibrationScene::instance) { CalibrationScene::instance = new CalibrationScene((!window ? &WindowWrapper::get_instance() : window), camera); }
+		return CalibrationScene::instance;
+    }
+
+    static void delete_instance() {
+		delete CalibrationScene::instance;
+		CalibrationScene::instance = nullptr;
+    }
+
+public:
+    // Virtual Functions
+    virtual void bind_callbacks();
+
+    virtual int main_loop();
+    virtual void pre_render();
+    virtual void render();
+    virtual inline void post_render() { glfwSwapBuffers(window->get_window()); }
+
+private:
+	static CalibrationScene* instance;
+
+    // Private Member Variables
+	UInt framebuffer;
+	UInt cube_map;
+
+	UInt multisample_framebuffer = 0;
+	UInt multisample_colour = 0;
+	UInt multisample_depth = 0;
+
+	Model terrain;
+	StaticBatch terrain_batch;
+	Model enemy_model;
+	std::vector<vec3> enemy_positions;
+
+	Text health_text;	// Moved over each enemy in turn
+	Text title;
+	Text progress;
+
+	PostProcess post_process;
+	FrameTimer frame_timer;
+
+	std::vector<CalibrationPreset> presets;
+	size_t current_preset = 0;
+	UInt frame = 0;
+	float measured_time = 0.0f;
+	float target_frame_time;
+	float finish_time = 0.0f;
+
+    // Private Member Functions
+	void init();
+
+	void setup_framebuffer();
+	void render_framebuffer();
+
+	void prepare_preset();
+	void setup_multisample_target(const int& samples);
+	void destroy_multisample_target();
+
+	void render_benchmark(const CalibrationPreset& preset);
+	void record_frame();
+	void save_preset(const CalibrationPreset& preset);
+
+	inline bool is_finished() const { return current_preset >= presets.size(); }
+	static std::vector<CalibrationPreset> get_presets();
+
+public:
+    // Callback functions
+	inline void window_close(GLFWwindow* window) { return_code = ReturnCodes::EXIT_GAME; }
+
+	static inline void WINDOW_CLOSE_HELPER(GLFWwindow* window) {
+		CalibrationScene::get_instance()->window_close(window);
+	}
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "BaseScene.hpp"
 #include "Cuboid.hpp"
+#include "StaticBatch.hpp"
 #include "Text.hpp"
 #include "WindowWrapper.hpp"
 #include "AttributeParser.hpp"
@@ -77,6 +78,9 @@ private:
     Cuboid bottom_column;
     Cuboid background;
 
+    // The five cuboids above merged, they never move after init
+    StaticBatch static_geometry;
+
     Text you_are_dead;
     Text score_text;
     Text please_type;
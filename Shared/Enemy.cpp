@@ -2,14 +2,16 @@
 #include "Model.hpp"
 #include "ResourceHandler.hpp"
 #include "GameHelpers.hpp"
+#include "ParticleSystem.hpp"
 
 const float Enemy::PATH_REFRESH_TIME = 2.5f;
+const float Enemy::WAYPOINT_RADIUS = 0.5f;
 
 Enemy::Enemy() : Character(),
 health_text(FileSystem::get_font("Mecha.ttf").string(), "100"),
 renderable(&cuboid) {
 
-	set_renderable(new Model(FileSystem::get_mesh("Enemy/icosphere.obj").string()), true);
+	set_renderable(new Model(MODEL_PATH()), true);
 
 	float height = bounding_box.get_aabb_max().y;
 	float width = bounding_box.get_aabb_max().x;
@@ -45,10 +47,6 @@ void Enemy::update(const float& time_delta){
         if (time_exploding >= 2.0f){ is_done = true; }
     }
     
-	if (path_counter >= PATH_REFRESH_TIME) {
-		path_counter = 0.0f;
-	}
-    
     ice_timer += time_delta;
     fire_timer += time_delta;
     
@@ -88,35 +86,110 @@ void Enemy::set_renderable(Renderable* new_renderable, bool dynamic_object) {
 	dynamic = dynamic_object;
 
 	bounding_box = SAT_OBB(dynamic_cast<Shape*>(renderable)->get_personal_vertices());
+
+	// Models loaded with a flat material colour start with that colour
+	Model* model = dynamic_cast<Model*>(renderable);
+	if (model && !model->meshes.empty() && !model->meshes.at(0).get_textures().empty()) {
+		const MeshTexture& texture = model->meshes.at(0).get_textures().front();
+		if (texture.texture_type == MeshTexture::COLOUR) { colour = vec3(texture.colour.r, texture.colour.g, texture.colour.b); }
+	}
 }
 
 void Enemy::render() {
-	if (do_explode) {
-		ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()).set_uniform<bool>("do_explode", true);
-		ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()).set_uniform<float>("time", time_exploding);
+	render_body();
+	render_health_text();
+}
 
-		glCullFace(GL_FRONT);
+void Enemy::render_body(const SHADER_ID& id) {
+	// Exploding only applies to the lit program, other programs get the plain body
+	bool exploding = do_explode && (id == Mesh::GENERIC_ID());
+
+	if (exploding) {
+		LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()));
+		light_program->set_feature(LightMapFeatures::GEOMETRY_EXPLODE, true);
+		light_program->set_uniform<float>("time", time_exploding);
+
+		// Both sides of the exploding shell are visible, drawn in one pass rather than one per face
+		glDisable(GL_CULL_FACE);
 	}
 
+	sync_renderable();
+    renderable->render(id);
+    //dynamic_cast<Renderable*>(&cuboid)->render();
+    
+    if (exploding){
+        glEnable(GL_CULL_FACE);
+		dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()))->set_feature(LightMapFeatures::GEOMETRY_EXPLODE, false);
+    }
+}
+
+void Enemy::submit_body(IndirectRenderer& renderer) {
+	Model* model = dynamic_cast<Model*>(renderable);
+	if (!model) {
+		render_body();
+		return;
+	}
+
+	sync_renderable();
+	renderer.submit(*model);
+}
+
+void Enemy::sync_renderable() {
 	Transformable* trans = dynamic_cast<Transformable*>(renderable);
 	trans->set_position(cuboid.get_position());
-    trans->set_quaternion(cuboid.get_quaternion());
-    trans->set_enlargement(cuboid.get_enlargement());
+	trans->set_quaternion(cuboid.get_quaternion());
+	trans->set_enlargement(cuboid.get_enlargement());
 	trans->set_rotation_point(cuboid.get_rotation_point());
+}
 
-    renderable->render();
-    //dynamic_cast<Renderable*>(&cuboid)->render();
-    
-    if (do_explode){
-        glCullFace(GL_BACK);
-		renderable->render();
-		ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()).set_uniform<bool>("do_explode", false);
-    }
+void Enemy::explode() {
+	if (do_explode) { return; }
+	do_explode = true;
+
+	ParticleEmitter debris = {
+		cuboid.get_position(),
+		vec3(0.0f, 4.0f, 0.0f),
+		vec3(1.0f, 0.55f, 0.2f),
+		8.0f,
+		1.5f,
+		0.3f,
+		9.8f
+	};
+
+	ParticleSystem::get_instance().burst(debris, 0.1f);
+}
 
+void Enemy::render_health_text() {
 	health_text.set_position(cuboid.get_position() + vec3(0.0f, 1.0f, 0.0f));
 	health_text.render("3DText");
 }
 
+void Enemy::submit_health_text(RenderQueue& queue) {
+	health_text.set_position(cuboid.get_position() + vec3(0.0f, 1.0f, 0.0f));
+	queue.submit(health_text, "3DText");
+}
+
+void Enemy::issue_occlusion_query(const vec3& view_position) {
+	occlusion_query.update();
+
+	// The proxy gets clipped by the near plane when the camera is inside it, which would wrongly report it as hidden
+	if (length(view_position - cuboid.get_position()) < (length(bounding_box.get_aabb_max()) * 2.0f + GameConstants::near_plane)) {
+		occlusion_query.set_visible(true);
+		return;
+	}
+
+	if (!occlusion_query.begin()) { return; }
+
+	// Exploding geometry is pushed outwards, so the proxy grows with it
+	const vec3 enlargement = cuboid.get_enlargement();
+	if (do_explode) { cuboid.set_enlargement(enlargement * (1.0f + time_exploding * 5.0f)); }
+
+	cuboid.render("DepthPrePass");
+	cuboid.set_enlargement(enlargement);
+
+	occlusion_query.end();
+}
+
 void Enemy::rotate_text_towards_position(const vec3& pos) {
 	vec3 dir = pos - cuboid.get_position();
 
@@ -140,6 +213,7 @@ void Enemy::hit(const Abilities& projectile_type) {
 		case (Abilities::POTATO) : {
 			health -= Potato::damage;
             new_texture.id = Shape::load_texture_from_rgba(Colours::WHITE);
+            set_colour(Colours::WHITE);
             
             if (model) {
                 model->meshes.at(0).set_textures({ new_texture });
@@ -151,6 +225,7 @@ void Enemy::hit(const Abilities& projectile_type) {
 		case (Abilities::FIREBALL) : {
 			health -= FireBall::damage;
             new_texture.id = Shape::load_texture_from_rgba(Colour(0.61f, 0.17f, 0.17f));
+            set_colour(Colour(0.61f, 0.17f, 0.17f));
             
             if (model) {
                 model->meshes.at(0).set_textures({ new_texture });
@@ -165,6 +240,7 @@ void Enemy::hit(const Abilities& projectile_type) {
 		case (Abilities::ICEBALL) : {
 			health -= IceBall::damage;
             new_texture.id = Shape::load_texture_from_rgba(Colour(0.83f, 0.94f, 1.0f));
+            set_colour(Colour(0.83f, 0.94f, 1.0f));
             
             if (model) {
                 model->meshes.at(0).set_textures({ new_texture });
@@ -186,36 +262,121 @@ void Enemy::hit(const Abilities& projectile_type) {
 	}
 }
 
-void Enemy::move_towards_closest_node(Map& map){
-    if (path.size() <= 1) {
-        target = vec3(0.0f);
-        
-    } else {
-		Node* next_node = get_next_node(map);
-		//Node* next_node = path.at(0);
+void Enemy::move_along_path() {
+	const vec3 position = cuboid.get_position();
 
-		vec3 next_node_pos(next_node->get_x(), cuboid.get_position().y, next_node->get_y());
+	// Waypoints are passed once close enough, or once the enemy is beyond them along the leg leading there
+	while (node_number < path.size()) {
+		const vec3& next_point = path.at(node_number);
+		const vec3& previous_point = path.at(node_number - 1);
 
-		target = normalise(next_node_pos - cuboid.get_position());
-    }
+		const vec3 to_next(next_point.x - position.x, 0.0f, next_point.z - position.z);
+		const vec3 leg(next_point.x - previous_point.x, 0.0f, next_point.z - previous_point.z);
+
+		if ((length_squared(to_next) > (WAYPOINT_RADIUS * WAYPOINT_RADIUS)) && (dot(to_next, leg) > 0.0f)) { break; }
+		++node_number;
+	}
+
+	if (node_number >= path.size()) {
+		target = vec3(0.0f);
+
+	} else {
+		const vec3 next_point(path.at(node_number).x, position.y, path.at(node_number).z);
+
+		target = normalise(next_point - position);
+	}
+}
+
+void Enemy::set_shortest_path(const std::vector<Node*>& shortest) {
+	path.clear();
+	grid_path.clear();
+	grid_indices.clear();
+
+	for (size_t iter = 0; iter < shortest.size(); ++iter) {
+		path.push_back(vec3(static_cast<float>(shortest.at(iter)->get_x()), 0.0f, static_cast<float>(shortest.at(iter)->get_y())));
+	}
+
+	node_number = 1;
 }
 
-Node* Enemy::get_next_node(Map& map) {
-	Node* closest = map.get_closest_node(get_cuboid()->get_position());
+void Enemy::set_grid_path(const std::vector<Node*>& new_grid_path, const std::vector<Node*>& smoothed) {
+	set_shortest_path(smoothed);
+	grid_path = new_grid_path;
+
+	// Smoothing only drops nodes, so each point is found further along the grid path than the last
+	size_t grid_index = 0;
+	for (size_t iter = 0; iter < smoothed.size(); ++iter) {
+		while ((grid_index < grid_path.size()) && (grid_path.at(grid_index) != smoothed.at(iter))) { ++grid_index; }
+		if (grid_index >= grid_path.size()) { throw std::runtime_error("Smoothed path is not part of the enemy's grid path"); }
 
-	for (size_t i = 0; i < path.size(); ++i) {
-		Node* path_node = path.at(i);
-		if (path_node == closest) {
+		grid_indices.push_back(grid_index);
+	}
+}
 
-			if ((i + 1) >= path.size()) {
-				return path_node;
-			}
+Node* Enemy::get_grid_path_node() const {
+	if (grid_indices.empty()) { return nullptr; }
 
-			Node* return_node = path.at(i + 1);
+	// The leg between the last point passed and the one being headed for, or the end once it is reached.
+	// Its grid nodes can be several nodes to either side of it, as any staircase between its ends is as short
+	const size_t last = std::min(node_number, grid_indices.size() - 1);
+	const size_t first = std::min(node_number - 1, last);
 
-			return return_node;
+	const vec3 position = cuboid.get_position();
+	Node* closest = nullptr;
+	float closest_distance = 0.0f;
+
+	for (size_t iter = grid_indices.at(first); iter <= grid_indices.at(last); ++iter) {
+		Node* node = grid_path.at(iter);
+		if (node->get_is_wall()) { continue; }
+
+		const vec3 offset(static_cast<float>(node->get_x()) - position.x, 0.0f, static_cast<float>(node->get_y()) - position.z);
+		if (!closest || (length_squared(offset) < closest_distance)) {
+			closest = node;
+			closest_distance = length_squared(offset);
 		}
 	}
 
 	return closest;
 }
+
+void Enemy::move_along_flow_field(Map& map) {
+	Node* current_node = map.get_closest_open_node(cuboid.get_position());
+	Node* next_node = current_node ? map.get_flow_node(current_node) : nullptr;
+
+	if (!next_node) {
+		target = vec3(0.0f);
+
+	} else {
+		vec3 next_node_pos(next_node->get_x(), cuboid.get_position().y, next_node->get_y());
+
+		target = normalise(next_node_pos - cuboid.get_position());
+	}
+}
+
+void Enemy::take_pending_path() {
+	if (PathfindingPool::is_ready(pending_path)) { set_shortest_path(pending_path.get()); }
+}
+
+void Enemy::set_waypoints(const std::vector<Node*>& new_waypoints) {
+	waypoints = new_waypoints;
+	waypoint_number = 0;
+	path.clear();
+	node_number = 1;
+}
+
+bool Enemy::needs_next_segment() const {
+	return ((waypoint_number + 1) < waypoints.size()) && (node_number >= path.size());
+}
+
+std::pair<Node*, Node*> Enemy::take_next_segment() {
+	if ((waypoint_number + 1) >= waypoints.size()) { throw std::runtime_error("Enemy has no waypoints left to head for"); }
+
+	const std::pair<Node*, Node*> segment(waypoints.at(waypoint_number), waypoints.at(waypoint_number + 1));
+	++waypoint_number;
+
+	return segment;
+}
+
+void Enemy::set_colour(const Colour& new_colour) {
+	colour = vec3(new_colour.red, new_colour.green, new_colour.blue);
+}
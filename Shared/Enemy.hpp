@@ -1,8 +1,14 @@
 #pragma once
 #include "Character.hpp"
 #include "Map.hpp"
+#include "IncrementalPath.hpp"
+#include "HierarchicalMap.hpp"
+#include "PathfindingPool.hpp"
 #include "Text.hpp"
 #include "Projectile.hpp"
+#include "OcclusionQuery.hpp"
+#include "IndirectRenderer.hpp"
+#include "RenderQueue.hpp"
 
 class Enemy : public Character {
     const float burn_timeout = 1.5f;
@@ -12,6 +18,10 @@ public:
     void operator=(const Enemy& other) = delete;
 
 	static const float PATH_REFRESH_TIME;
+	static const float WAYPOINT_RADIUS;		// How close to a waypoint counts as having reached it
+
+	// This is a function because the value is determined at runtime
+	static inline std::string MODEL_PATH() { return FileSystem::get_mesh("Enemy/icosphere.obj").string(); }
     
 public:
     Enemy();
@@ -19,21 +29,54 @@ public:
     
     virtual void update(const float& time_delta);
     virtual void render();
+	void render_body(const SHADER_ID& id = Shape::GENERIC_ID());
+
+	// Queues the body to be drawn by the renderer instead, bodies that aren't models are drawn straight away
+	void submit_body(IndirectRenderer& renderer);
+	void render_health_text();
+	void submit_health_text(RenderQueue& queue);	// Drawn with the other transparent surfaces, back to front
+
+	// Draws the bounding cuboid as an occlusion proxy, colour and depth writes must already be disabled
+	void issue_occlusion_query(const vec3& view_position);
+	inline bool is_visible() const { return occlusion_query.is_visible(); }
+
+	// Used to draw the enemy as an impostor, which is baked white and tinted
+	inline vec3 get_colour() const { return colour; }
+	inline float get_bounding_radius() const { return length(bounding_box.get_aabb_max()); }
     
-    void move_towards_closest_node(Map& map);
+	// Heads for the waypoint at the path's cursor, which only moves forward so no searching of the path is needed
+	void move_along_path();
+	void move_along_flow_field(Map& map);	// Ignores the enemy's own path, the map's flow field must be up to date
     
 	void set_renderable(Renderable* new_renderable, bool dynamic_object);
     
-    inline void explode() { do_explode = true; }
+    void explode();
     
     inline float get_time_exploding(){ return time_exploding; }
     inline bool get_is_exploding() const { return do_explode; }
     inline bool get_is_done() const { return is_done; }
-    inline void set_shortest_path(const std::vector<Node*>& shortest) { path = shortest; node_number = 1; }
+    void set_shortest_path(const std::vector<Node*>& shortest);
+	inline void set_path(const std::vector<vec3>& points) { path = points; node_number = 1; }	// Only x and z are followed
+	inline IncrementalPath& get_incremental_path() { return incremental_path; }
+
+	// The smoothed path is followed, the grid path it was cut from is kept so repairs can start from a node on it
+	void set_grid_path(const std::vector<Node*>& new_grid_path, const std::vector<Node*>& smoothed);
+	Node* get_grid_path_node() const;	// Closest open node of the leg being walked, null without a grid path
+
+	// Paths searched in the background replace the current one once they are ready, an invalid future drops any pending
+	inline void set_pending_path(std::future<std::vector<Node*>>&& path) { pending_path = std::move(path); }
+	inline bool has_pending_path() const { return pending_path.valid(); }
+	void take_pending_path();
+
+	// Abstract paths are followed one leg at a time, each refined into the enemy's path once the last is walked
+	void set_waypoints(const std::vector<Node*>& new_waypoints);
+	bool needs_next_segment() const;
+	std::pair<Node*, Node*> take_next_segment();
     inline void set_is_done(const bool new_done) { is_done = new_done; }
     
     inline float get_path_counter() { return path_counter; }
     inline void add_count(const float& time_delta) { path_counter += time_delta; }
+	inline void reset_path_counter() { path_counter = 0.0f; }	// Once its path has been refreshed, which may be frames after it was due
 
 	void rotate_text_towards_position(const vec3& pos);
 
@@ -50,15 +93,25 @@ private:
     
     float time_exploding = 0.0f;
 
-	int node_number = 1;
-    std::vector<Node*> path;
+	size_t node_number = 1;		// The cursor, the waypoint being headed for
+    std::vector<vec3> path;		// Grid paths are kept as their nodes' positions, so navigation mesh paths can be followed too
+	IncrementalPath incremental_path;	// Only searched in the incremental navigation mode
+	std::vector<Node*> grid_path;		// Only kept in the incremental navigation mode
+	std::vector<size_t> grid_indices;	// Where each point of the path lies on the grid path
+	std::future<std::vector<Node*>> pending_path;
+	std::vector<Node*> waypoints;		// Only set in the hierarchical navigation mode
+	size_t waypoint_number = 0;			// The waypoint the current path starts from
     Node* top_node = nullptr;
     vec3 target;
     float path_counter = 0.0f;
 
 	int health = 100;
+	vec3 colour = vec3(1.0f);
 	Text health_text;
 	vec3 text_normal = vec3(0.0f, 0.0f, 1.0f);
 
-	Node* get_next_node(Map& map);
+	OcclusionQuery occlusion_query;
+
+	void sync_renderable();
+	void set_colour(const Colour& new_colour);
 };
@@ -53,10 +53,12 @@ namespace FileSystem {
 	static inline fs::path get_fonts_dir() { return join(get_resource_dir(), "fonts"); }
     static inline fs::path get_meshes_dir() { return join(get_resource_dir(), "meshes"); }
 	static inline fs::path get_textures_dir() { return join(get_resource_dir(), "textures"); }
+	static inline fs::path get_maps_dir() { return join(get_resource_dir(), "maps"); }
     static inline fs::path get_shader(const std::string& name){ return join(get_shaders_dir(), name); }
     static inline fs::path get_font(const std::string& name){ return join(get_fonts_dir(), name); }
     static inline fs::path get_mesh(const std::string& name) { return join(get_meshes_dir(), name); }
 	static inline fs::path get_texture(const std::string& name) { return join(get_textures_dir(), name); }
+	static inline fs::path get_map(const std::string& name) { return join(get_maps_dir(), name); }
 }
 
 namespace GameConstants {
@@ -78,6 +80,9 @@ namespace GameConstants {
     
     static const float far_plane = 5000.0f;
     static const float near_plane = 0.1f;
+	static const float target_frame_time = 1000.0f / 60.0f;	// Milliseconds, held by lowering the render quality
+	static const float ai_frame_budget = 1000.0f;				// Microseconds of enemy path searching per frame
+	static const UInt spawn_attempts = 32;						// Points tried in the spawn zones before settling for the nearest open node
     static const float FOV = 1.0471975512f; // 60 degrees in radians (pi / 3)
     static const float SHADOW_FOV = 1.57079632679f; // 90 degrees in radians (pi / 2)
 
@@ -88,6 +93,11 @@ namespace Options {
 	static const std::string MULTISAMPLING = "MULTISAMPLING";
 	static const std::string SHADOWS = "SHADOWS";
 	static const std::string FULLSCREEN = "FULLSCREEN";
+	static const std::string DEPTH_PREPASS = "DEPTH_PREPASS";
+	static const std::string RENDER_PATH = "RENDER_PATH";
+	static const std::string ANTI_ALIASING = "ANTI_ALIASING";	// "Off" or "FXAA", applied after the frame unlike MULTISAMPLING
+	static const std::string CALIBRATED = "CALIBRATED";			// Missing until the calibration has picked the options above
+	static const std::string NAVIGATION = "NAVIGATION";			// "FlowField" shared by every enemy, or "AStar", "JumpPoint", "Incremental", "Hierarchical" or "NavigationMesh" for a path each
 }
 
 template <typename First, typename Second>
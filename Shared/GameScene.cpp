@@ -5,6 +5,7 @@
 #include "SkyBox.hpp"
 #include "Camera.hpp"
 #include "AttributeParser.hpp"
+#include "ParticleSystem.hpp"
 
 GameScene* GameScene::instance = nullptr;
 
@@ -13,18 +14,30 @@ GameScene::GameScene(WindowWrapper* window, Camera* camera) : BaseScene(window,
 player(player_square_dimension, player_height, player_square_dimension, camera),
 sky(FileSystem::get_texture("SkyBox").string()),
 terrain(FileSystem::get_mesh("Scene/ORIGINAL.obj").string()),
-node_map(get_nodes()),
+map_file(FileSystem::get_map("ORIGINAL.map").string()),
+node_map(map_file),
+hierarchical_map(node_map),
+pathfinding_pool(node_map),
+ai_scheduler(GameConstants::ai_frame_budget),
+deferred_renderer(window->width(), window->height()),
+post_process(window->width(), window->height()),
+quality_governor(get_quality_levels(), GameConstants::target_frame_time),
 wave_text(GameConstants::MECHA(), ""),
 pause_menu_title(GameConstants::MECHA(), "Game Paused"),
 resume_text(GameConstants::MECHA(), "Resume Game"),
 exit_to_main_menu(GameConstants::MECHA(), "Exit to Main Menu"),
-exit_game(GameConstants::MECHA(), "Exit Game"){
+exit_game(GameConstants::MECHA(), "Exit Game"),
+quality_text(GameConstants::ARIAL(), ""){
 
 	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Cube::GENERIC_ID()));
 	if (light_program) { light_program->reset(); }
 
+	ParticleSystem::get_instance().clear();
+
 	bind_callbacks();
 	init();
+	navigation_mesh.build(terrain);
+	setup_nodes();
 	setup_framebuffer();
 
 	std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
@@ -32,12 +45,24 @@ exit_game(GameConstants::MECHA(), "Exit Game"){
 	ResourceHandler& instance = ResourceHandler::get_instance();
 	instance.get_program(Text::GENERIC_ID()).set_uniform<mat4>("VP", text_vp);
 	instance.get_program("OrthoShape").set_uniform<mat4>("VP", text_vp);
-	instance.get_program(Mesh::GENERIC_ID()).set_uniform<float>("far_plane", GameConstants::far_plane);
-	instance.get_program(Mesh::GENERIC_ID()).set_uniform<bool>("use_light_colour", true);
+	instance.get_program(Mesh::GENERIC_ID()).set_persistent_uniform<float>("far_plane", GameConstants::far_plane);
+	if (light_program) { light_program->set_feature(LightMapFeatures::LIGHT_COLOUR, true); }
+
+
+	bake_enemy_impostor();
+
+	// The terrain never moves, so its meshes are merged by material up front
+	terrain_batch.add(terrain);
+	terrain_batch.build();
 }
 
 GameScene::~GameScene(){
     MemoryManagement::delete_all_from_vector(enemies);
+	Model::clear_lod_view();
+
+	// The other scenes share the lit program and always render at full quality
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+	light_program->set_quality_tier(LightMapFeatures::HIGH_QUALITY);
 }
 
 void GameScene::bind_callbacks(){
@@ -63,6 +88,10 @@ int GameScene::main_loop(){
 void GameScene::pre_render(){
 	check_errors("Main Loop Pre-Render");
 
+	// Paused frames barely touch the GPU and would wrongly suggest the quality can be raised
+	if (!pause_activated && quality_governor.update(frame_timer.get_gpu_time())) { apply_quality_level(); }
+	frame_timer.begin_frame();
+
     float current_frame_time = static_cast<float>(glfwGetTime());
     frame_time_delta = current_frame_time - last_frame_time;
     last_frame_time = current_frame_time;
@@ -70,12 +99,16 @@ void GameScene::pre_render(){
 	wave_text_timer += frame_time_delta;
 
 	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
-    light_program->set_uniform<bool>("use_shadows", use_shadows);
+    light_program->set_feature(LightMapFeatures::SHADOWS, use_shadows);
+
+	// Levels of detail are chosen from the player's view for every pass this frame, shadows included
+	const float viewport_height = static_cast<float>(window->get_window_dimensions().second);
+	Model::set_lod_view(camera->get_position(), viewport_height / (2.0f * std::tan(GameConstants::FOV / 2.0f)));
 
 	if (using_shadows()) {
 		glActiveTexture(GL_TEXTURE31);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
-		ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_uniform<int>("depth_map", 31);
+		ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_persistent_uniform<int>("depth_map", 31);
 
 		render_framebuffer();
 	}
@@ -105,6 +138,8 @@ void GameScene::pre_render(){
 		evaluate_player_collisions();
 		update_enemies();
 
+		ParticleSystem::get_instance().update(frame_time_delta);
+
 	} else {
 		if (pause_activated) {
 
@@ -122,6 +157,16 @@ void GameScene::pre_render(){
 
 	AttributeParser parser(FileSystem::join(FileSystem::get_resource_dir(), "OPTIONS").string());
 	use_shadows = parser.get_attribute(Options::SHADOWS) == "On" ? true : false;
+	use_depth_prepass = parser.get_attribute(Options::DEPTH_PREPASS) == "On" ? true : false;
+	use_deferred = parser.get_attribute(Options::RENDER_PATH) == "Deferred" ? true : false;
+	use_fxaa = parser.get_attribute(Options::ANTI_ALIASING) == "FXAA" ? true : false;
+	const std::string navigation = parser.get_attribute(Options::NAVIGATION);
+	navigation_mode = NavigationModes::FLOW_FIELD;
+	if (navigation == "AStar") { navigation_mode = NavigationModes::A_STAR; }
+	else if (navigation == "Incremental") { navigation_mode = NavigationModes::INCREMENTAL; }
+	else if (navigation == "Hierarchical") { navigation_mode = NavigationModes::HIERARCHICAL; }
+	else if (navigation == "JumpPoint") { navigation_mode = NavigationModes::JUMP_POINT; }
+	else if (navigation == "NavigationMesh") { navigation_mode = NavigationModes::NAVIGATION_MESH; }
 }
 
 void GameScene::render(){
@@ -129,13 +174,21 @@ void GameScene::render(){
     mat4 view_matrix = camera->get_custom_view();
 	GLfloat aspect_ratio = window_dimensions.first / window_dimensions.second;
 
-    mat4 vp =  perspective(GameConstants::FOV, aspect_ratio, GameConstants::near_plane, GameConstants::far_plane) * view_matrix;
+    mat4 projection = perspective(GameConstants::FOV, aspect_ratio, GameConstants::near_plane, GameConstants::far_plane);
+    mat4 vp = projection * view_matrix;
+	const Frustum view_frustum(vp);
 
 	ResourceHandler& instance = ResourceHandler::get_instance();
-	instance.get_program(Mesh::GENERIC_ID()).set_uniform<mat4>("VP", vp);
-	instance.get_program(Mesh::GENERIC_ID()).set_uniform<vec3>("view_position", camera->get_position());
+	instance.get_program(Mesh::GENERIC_ID()).set_persistent_uniform<mat4>("VP", vp);
+	instance.get_program(Mesh::GENERIC_ID()).set_persistent_uniform<vec3>("view_position", camera->get_position());
 	instance.get_program(SkyBox::GENERIC_ID()).set_uniform<mat4>("VP", vp);
 	instance.get_program("3DText").set_uniform<mat4>("VP", vp);
+	instance.get_program("DepthPrePass").set_uniform<mat4>("VP", vp);
+
+	// The scene is drawn offscreen when it is anti-aliased or upscaled afterwards
+	const float render_scale = quality_governor.get_level().render_scale;
+	const bool render_offscreen = !pause_activated && (use_fxaa || (render_scale < 1.0f));
+	if (render_offscreen) { post_process.begin(static_cast<UInt>(window_dimensions.first), static_cast<UInt>(window_dimensions.second), render_scale); }
 
 	if (pause_activated) {
 		const float minimum_value = 0.2f;
@@ -154,25 +207,78 @@ void GameScene::render(){
 		dynamic_cast<Renderable*>(&exit_to_main_menu)->render();
 		dynamic_cast<Renderable*>(&exit_game)->render();
 
+	} else if (use_deferred) {
+		render_deferred(vp, projection, render_offscreen ? &post_process.get_target() : nullptr);
+
 	} else {
+		if (use_depth_prepass) {
+			render_depth_prepass(view_frustum);
+
+			// Depth is already resolved, so only the visible fragment of the opaque geometry gets shaded
+			glDepthFunc(GL_LEQUAL);
+			glDepthMask(GL_FALSE);
+		}
+
+		// Opaque geometry covered by the depth pre-pass
+		terrain_batch.render(Shape::GENERIC_ID(), &view_frustum);
+		if (!use_depth_prepass) { issue_occlusion_queries(); }
+
+		// Where supported, nearby enemies are culled on the GPU and drawn with one indirect draw per material
+		const bool use_indirect_draws = IndirectRenderer::is_supported();
+
+		for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
+			Enemy* enemy = enemies.at(enemy_iter);
+			if (enemy->get_is_exploding() || !enemy->is_visible() || (get_enemy_fade_out(enemy) > 0.0f)) { continue; }
+
+			if (use_indirect_draws) { enemy->submit_body(enemy_renderer); }
+			else { enemy->render_body(); }
+		}
+
+		if (use_indirect_draws) { enemy_renderer.render(Shape::GENERIC_ID(), view_frustum); }
+
+		if (use_depth_prepass) {
+			glDepthMask(GL_TRUE);
+			glDepthFunc(GL_LESS);
+		}
+
+		// Distant enemies were left out of the pre-pass as their dithered pixels must not write depth early
+		render_distant_enemies(Shape::GENERIC_ID());
+		enemy_impostor.render(view_matrix, projection, camera->get_position());
+
 		for (size_t renderable_iter = 0; renderable_iter < renderables.size(); ++renderable_iter) {
-			Renderable* renderable = renderables.at(renderable_iter);
-			renderable->render();
+			render_queue.submit(*renderables.at(renderable_iter));
 		}
 
-		dynamic_cast<Renderable*>(&terrain)->render();
-		dynamic_cast<Renderable*>(&sky)->render();
-		dynamic_cast<Renderable*>(&sun)->render();
+		render_queue.submit(sky);
+		render_queue.submit(sun);
 
 		player.render();
 
 		for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
-			enemies.at(enemy_iter)->rotate_text_towards_position(camera->get_position());
-			enemies.at(enemy_iter)->render();
+			Enemy* enemy = enemies.at(enemy_iter);
+			if (!enemy->is_visible()) { continue; }
+			if (enemy->get_is_exploding()) { enemy->render_body(); }
+
+			enemy->rotate_text_towards_position(camera->get_position());
+			enemy->submit_health_text(render_queue);
 		}
 
+		submit_particles(view_matrix, projection);
+		player.submit_hud(render_queue);
+
+		render_queue.flush(camera->get_position());
+	}
+
+	if (render_offscreen) { post_process.end(static_cast<UInt>(window_dimensions.first), static_cast<UInt>(window_dimensions.second), use_fxaa); }
+
+	// The HUD is drawn at the window's resolution, over the upscaled scene
+	if (!pause_activated) {
+		render_queue.flush_overlays();
 		display_wave_text();
 	}
+
+	if (show_quality_overlay) { display_quality_overlay(); }
+	frame_timer.end_frame();
 }
 
 // Member Functions
@@ -193,17 +299,7 @@ void GameScene::setup_framebuffer() {
     glGenTextures(1, &cube_map);
     
     glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
-    for (size_t face_iter = 0; face_iter < 6; ++face_iter){
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<unsigned int>(face_iter),
-					 0,
-                     GL_DEPTH_COMPONENT,
-					 GameConstants::framebuffer_depth_resolution,
-					 GameConstants::framebuffer_depth_resolution,
-                     0,
-					 GL_DEPTH_COMPONENT,
-					 GL_FLOAT,
-					 nullptr);
-    }
+	allocate_shadow_map();
     
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -223,6 +319,68 @@ void GameScene::setup_framebuffer() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void GameScene::allocate_shadow_map() {
+	// Expects the cube map to be bound, storage is re-specified in place so the framebuffer attachment stays valid
+	for (size_t face_iter = 0; face_iter < 6; ++face_iter){
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<unsigned int>(face_iter),
+					 0,
+					 GL_DEPTH_COMPONENT,
+					 shadow_resolution,
+					 shadow_resolution,
+					 0,
+					 GL_DEPTH_COMPONENT,
+					 GL_FLOAT,
+					 nullptr);
+	}
+}
+
+void GameScene::apply_quality_level() {
+	const QualityLevel& level = quality_governor.get_level();
+
+	if (level.shadow_resolution != shadow_resolution) {
+		shadow_resolution = level.shadow_resolution;
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
+		allocate_shadow_map();
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	}
+
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+	light_program->set_quality_tier(level.shadow_quality_tier);
+}
+
+void GameScene::display_quality_overlay() {
+	const QualityLevel& level = quality_governor.get_level();
+	std::stringstream overlay;
+	overlay.precision(1);
+
+	overlay << std::fixed << "Quality " << (quality_governor.get_level_index() + 1) << "/" << quality_governor.get_level_count()
+			<< " | Scale " << static_cast<int>(level.render_scale * 100.0f) << "%"
+			<< " | Shadows " << level.shadow_resolution << " x" << LightMapFeatures::get_shadow_taps(level.shadow_quality_tier)
+			<< " | CPU " << frame_timer.get_cpu_time() << "ms"
+			<< " | GPU " << frame_timer.get_gpu_time() << "ms / " << quality_governor.get_target_frame_time() << "ms"
+			<< " | " << (use_deferred ? "Deferred" : "Forward")
+			<< " | Pre-pass " << (use_depth_prepass ? "On" : "Off")
+			<< " | " << get_navigation_name();
+
+	quality_text.set_text(overlay.str());
+	quality_text.set_y(window->get_window_dimensions().second - quality_text.get_height() - 10.0f);
+	dynamic_cast<Renderable*>(&quality_text)->render();
+}
+
+std::vector<QualityLevel> GameScene::get_quality_levels() {
+	const UInt resolution = GameConstants::framebuffer_depth_resolution;
+
+	// Filtering taps are cheapest to give up, then resolution and shadow detail go together
+	return {
+		{ 1.0f,		resolution,		LightMapFeatures::HIGH_QUALITY },
+		{ 1.0f,		resolution,		LightMapFeatures::MEDIUM_QUALITY },
+		{ 0.85f,	resolution / 2, LightMapFeatures::MEDIUM_QUALITY },
+		{ 0.7f,		resolution / 2, LightMapFeatures::LOW_QUALITY },
+		{ 0.5f,		resolution / 4, LightMapFeatures::LOW_QUALITY }
+	};
+}
+
 void GameScene::render_framebuffer() {
     if (!use_shadows) { return; }
     LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
@@ -240,7 +398,7 @@ void GameScene::render_framebuffer() {
     // Render scene to depth cubemap
     Program& depth_shader = ResourceHandler::get_instance().get_program("Shadow");
     
-    glViewport(0, 0, GameConstants::framebuffer_depth_resolution, GameConstants::framebuffer_depth_resolution);
+    glViewport(0, 0, shadow_resolution, shadow_resolution);
     glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
     glClear(GL_DEPTH_BUFFER_BIT);
     
@@ -256,12 +414,179 @@ void GameScene::render_framebuffer() {
         renderable->render("Shadow");
     }
     
-    terrain.render("Shadow");
+    terrain_batch.render("Shadow");
     player.get_cuboid()->render("Shadow");
     
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void GameScene::render_depth_prepass(const Frustum& view_frustum) {
+	// Exploding enemies are left out as their geometry is displaced in the lit geometry shader
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+	terrain_batch.render("DepthPrePass", &view_frustum);
+	issue_occlusion_queries();
+
+	for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
+		Enemy* enemy = enemies.at(enemy_iter);
+		if (!enemy->get_is_exploding() && enemy->is_visible() && (get_enemy_fade_out(enemy) <= 0.0f)) { enemy->render_body("DepthPrePass"); }
+	}
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void GameScene::issue_occlusion_queries() {
+	// Proxies are tested against the terrain depth only, results are used from the next frame onwards
+	GLboolean colour_mask[4];
+	GLboolean depth_mask;
+	glGetBooleanv(GL_COLOR_WRITEMASK, colour_mask);
+	glGetBooleanv(GL_DEPTH_WRITEMASK, &depth_mask);
+
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+	glDisable(GL_CULL_FACE);
+
+	for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
+		enemies.at(enemy_iter)->issue_occlusion_query(camera->get_position());
+	}
+
+	glEnable(GL_CULL_FACE);
+	glDepthMask(depth_mask);
+	glColorMask(colour_mask[0], colour_mask[1], colour_mask[2], colour_mask[3]);
+}
+
+void GameScene::toggle_depth_prepass() {
+	use_depth_prepass = !use_depth_prepass;
+
+	// Saved straight away as the options are re-read every frame
+	AttributeParser parser(GameConstants::OPTIONS());
+	parser.change_attribute(Options::DEPTH_PREPASS, use_depth_prepass ? "On" : "Off");
+}
+
+void GameScene::render_deferred(const mat4& vp, const mat4& projection, const RenderTarget* destination) {
+	std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+
+	// The G-buffer matches whatever it is composited into, which is smaller than the window when scaled down
+	const UInt width = destination ? destination->get_width() : window_dimensions.first;
+	const UInt height = destination ? destination->get_height() : window_dimensions.second;
+
+	// Opaque geometry is written to the G-buffer, the depth pre-pass is not needed here
+	deferred_renderer.begin_geometry_pass(vp, width, height);
+	const Frustum view_frustum(vp);
+
+	for (size_t renderable_iter = 0; renderable_iter < renderables.size(); ++renderable_iter) {
+		renderables.at(renderable_iter)->render(DeferredRenderer::GEOMETRY_ID());
+	}
+
+	terrain_batch.render(DeferredRenderer::GEOMETRY_ID(), &view_frustum);
+	issue_occlusion_queries();
+
+	for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
+		Enemy* enemy = enemies.at(enemy_iter);
+		if (!enemy->get_is_exploding() && enemy->is_visible() && (get_enemy_fade_out(enemy) <= 0.0f)) { enemy->render_body(DeferredRenderer::GEOMETRY_ID()); }
+	}
+
+	render_distant_enemies(DeferredRenderer::GEOMETRY_ID());
+
+	deferred_renderer.light_pass(*light_program, vp, camera->get_position(), cube_map, using_shadows(), GameConstants::far_plane);
+
+	// Anything the G-buffer cannot represent is drawn forward over the lit result
+	deferred_renderer.begin_forward_pass();
+
+	render_queue.submit(sky);
+	render_queue.submit(sun);
+
+	player.render();
+
+	// Impostors carry baked lighting, so they are drawn forward rather than into the G-buffer
+	enemy_impostor.render(camera->get_custom_view(), projection, camera->get_position());
+
+	for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
+		Enemy* enemy = enemies.at(enemy_iter);
+		if (!enemy->is_visible()) { continue; }
+		if (enemy->get_is_exploding()) { enemy->render_body(); }
+
+		enemy->rotate_text_towards_position(camera->get_position());
+		enemy->submit_health_text(render_queue);
+	}
+
+	submit_particles(camera->get_custom_view(), projection);
+	player.submit_hud(render_queue);
+
+	render_queue.flush(camera->get_position());
+
+	deferred_renderer.composite(width, height, destination);
+}
+
+void GameScene::submit_particles(const mat4& view, const mat4& projection) {
+	// Additive blending does not depend on order, so they are simply sorted as if at the camera (drawn last)
+	render_queue.submit_transparent(camera->get_position(), [view, projection]() {
+		ParticleSystem::get_instance().render(view, projection);
+	});
+}
+
+void GameScene::toggle_render_path() {
+	use_deferred = !use_deferred;
+
+	AttributeParser parser(GameConstants::OPTIONS());
+	parser.change_attribute(Options::RENDER_PATH, use_deferred ? "Deferred" : "Forward");
+}
+
+void GameScene::bake_enemy_impostor() {
+	// Baked white from the enemy's spawn height at the centre of the map, each instance is tinted with its enemy's colour
+	Model model(Enemy::MODEL_PATH());
+	MeshTexture white = { MeshTexture::TEXTURE, static_cast<int>(Shape::load_texture_from_rgba(Colours::WHITE)), "texture_diffuse" };
+
+	for (size_t mesh_iter = 0; mesh_iter < model.meshes.size(); ++mesh_iter) {
+		model.meshes.at(mesh_iter).set_textures({ white });
+	}
+
+	// The shadow map has not been rendered yet
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
+	const bool had_shadows = light_program->has_feature(LightMapFeatures::SHADOWS);
+	light_program->set_feature(LightMapFeatures::SHADOWS, false);
+
+	enemy_impostor.bake(model, Shape::GENERIC_ID());
+
+	light_program->set_feature(LightMapFeatures::SHADOWS, had_shadows);
+}
+
+float GameScene::get_enemy_fade_out(Enemy* enemy) {
+	if (enemy->get_is_exploding()) { return 0.0f; }
+
+	const float view_distance = distance(camera->get_position(), enemy->get_cuboid()->get_position());
+	return std::max(0.0f, std::min(1.0f, (view_distance - impostor_distance) / impostor_fade_distance));
+}
+
+void GameScene::render_distant_enemies(const SHADER_ID& id) {
+	// Enemies past the impostor distance are queued as impostors, those still fading are dithered against them
+	Program& program = ResourceHandler::get_instance().get_program(id);
+	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&program);
+
+	for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {
+		Enemy* enemy = enemies.at(enemy_iter);
+		if (enemy->get_is_exploding() || !enemy->is_visible()) { continue; }
+
+		const float fade_out = get_enemy_fade_out(enemy);
+		if (fade_out <= 0.0f) { continue; }
+
+		Cuboid* cuboid = enemy->get_cuboid();
+		const vec3 enlargement = cuboid->get_enlargement();
+		const float scale = std::max(enlargement.x, std::max(enlargement.y, enlargement.z));
+		enemy_impostor.add_instance(cuboid->get_position(), cuboid->get_quaternion(), enemy->get_bounding_radius() * scale, enemy->get_colour(), fade_out);
+
+		if (fade_out >= 1.0f) { continue; }
+
+		if (light_program) { light_program->set_feature(LightMapFeatures::DITHER_FADE, true); }
+		program.set_uniform<float>("fade_out", fade_out);
+		enemy->render_body(id);
+	}
+
+	if (light_program) { light_program->set_feature(LightMapFeatures::DITHER_FADE, false); }
+	program.set_uniform<float>("fade_out", 0.0f);
+}
+
 void GameScene::init(){
     camera->set_position(vec3(0.0f, 5.0f, 20.0f));
     sky.enlarge(GameConstants::far_plane * 0.75f);
@@ -291,6 +616,10 @@ void GameScene::init(){
 	wave_text.set_scale(0.6f);
 	wave_text.set_colour(Colours::WHITE);
 
+	quality_text.set_scale(0.1f);
+	quality_text.set_x(10.0f);
+	quality_text.set_colour(Colours::WHITE);
+
 	// Menu
 	std::pair<UInt, UInt> window_dimensions = window->get_window_dimensions();
 	vec3 orthogonal_screen_centre(window_dimensions.first / 2.0f, window_dimensions.second / 2.0f, 0.0f);
@@ -363,41 +692,30 @@ void GameScene::display_wave_text() {
 	}
 }
 
-std::vector<std::vector<Node*>> GameScene::get_nodes(){
-    std::vector<std::vector<Node*>> node_array;
-    
-    const std::vector<vec2> wall_blocks = {
-		// TODO: Do something with this (old content)
-    };
+void GameScene::setup_nodes(){
+    // Walls from the map file are already in place, only the navigation mesh's are added
+    if (navigation_mesh.get_polygon_count() == 0) { return; }
 
-    for (int x = x_lower_bound; x <= x_upper_including; x += 2){
-        std::vector<Node*> current_row;
-        
-        for (int z = z_lower_bound; z <= z_upper_including; z += 2){
-            Node* new_node = new Node(x, z);
+    for (size_t x_iter = 0; x_iter < node_map.get_node_map_size(); ++x_iter){
+        for (size_t z_iter = 0; z_iter < node_map.get_node_column_size(x_iter); ++z_iter){
+            Node* node = node_map.get_node(x_iter, z_iter);
+            const int x = node->get_x();
+            const int z = node->get_y();
             
             //Cube* cube = new Cube;
             //cube->set_position(vec3(x, 2.0f, z));
             //renderables.push_back(cube);
             
-            if ((x <= x_lower_bound)  ||
-                (x >= x_upper_including)   ||
-                (z <= z_lower_bound)  ||
-                (z >= z_upper_including)   ||
-                (std::find(wall_blocks.begin(), wall_blocks.end(), vec2(static_cast<float>(x), static_cast<float>(z))) != wall_blocks.end())) {
-                
-                new_node->set_wall(true);
+            // Columns the navigation mesh found blocked or unreachable
+            if (!navigation_mesh.is_walkable(vec3(static_cast<float>(x), 0.0f, static_cast<float>(z)))) {
+                node->set_wall(true);
                 //cube->set_texture(Shape::load_texture_from_rgba(Colours::BLUE));
             }
-
-            current_row.push_back(new_node);
-            
         }
-        
-        node_array.push_back(current_row);
     }
-    
-    return node_array;
+
+    // Walls were set on the nodes directly, so the map cannot tell which are cut off until told. This is why the map file stores no components
+    node_map.update_components();
 }
 
 void GameScene::spawn_wave() {
@@ -410,18 +728,41 @@ void GameScene::spawn_wave() {
 }
 
 void GameScene::spawn_enemy(){
-    vec3 position(
-		get_random<float>(-80.0f, 80.0f),
-		0.0f,
-		get_random<float>(-80.0f, 80.0f)
-	);
+    vec3 position = get_spawn_position();
     
     Enemy* new_enemy = new Enemy;
     new_enemy->get_cuboid()->move(position);   
-	new_enemy->set_shortest_path(node_map.a_star_pathfind(node_map.get_closest_node(position), node_map.get_closest_node(player.get_cuboid()->get_position())));
+
+	// A whole wave's first searches are spread over the following frames rather than made here
+	if (navigation_mode != NavigationModes::FLOW_FIELD) { ai_scheduler.request(new_enemy); }
+
     enemies.push_back(new_enemy);
 }
 
+vec3 GameScene::get_spawn_position() {
+	const std::vector<SpawnZone>& zones = map_file.get_spawn_zones();
+	if (zones.empty()) { throw std::runtime_error("The map has nowhere for enemies to spawn"); }
+
+	Node* player_node = node_map.get_closest_open_node(player.get_cuboid()->get_position());
+	vec3 position;
+
+	// Zones are drawn as rectangles over the walls, an enemy placed in a wall's cell could never find a path
+	for (UInt attempt = 0; attempt < GameConstants::spawn_attempts; ++attempt) {
+		const SpawnZone& zone = zones.at(static_cast<size_t>(get_random<int>(0, static_cast<int>(zones.size()) - 1)));
+		position = vec3(get_random<float>(zone.min_x, zone.max_x), 0.0f, get_random<float>(zone.min_z, zone.max_z));
+
+		Node* node = node_map.get_closest_node(position);
+		if (node->get_is_wall()) { continue; }
+		if (!player_node || node_map.may_reach(node_map.get_index(node), node_map.get_index(player_node))) { return position; }
+	}
+
+	// Zones that are almost entirely walled off, the last point tried is moved out of the wall instead
+	Node* open_node = node_map.get_closest_open_node(position);
+	if (!open_node) { throw std::runtime_error("The map has nowhere open for enemies to spawn"); }
+
+	return vec3(static_cast<float>(open_node->get_x()), 0.0f, static_cast<float>(open_node->get_y()));
+}
+
 void GameScene::evaluate_enemy_collisions(){
 	for (size_t enemy_iter = 0; enemy_iter < enemies.size(); ++enemy_iter) {	
 		Enemy* current_enemy = enemies.at(enemy_iter);
@@ -434,10 +775,7 @@ void GameScene::evaluate_enemy_collisions(){
 			(pos.z < z_lower_collision)) {
             
             current_enemy->get_cuboid()->move(vec3(-pos.x, 0.0f, -pos.z));
-            current_enemy->get_cuboid()->move(vec3(get_random<float>(-80.0f, 80.0f),
-                                                            0.0f,
-                                                        get_random<float>(-80.0f, 80.0f)
-                                                        ));
+            current_enemy->get_cuboid()->move(get_spawn_position());
 			continue;
 		}
 
@@ -491,6 +829,7 @@ void GameScene::evaluate_player_collisions() {
 		if (player.check_colliding(collidable)) {
 			player.enemy_hit();
 
+			ai_scheduler.cancel(enemies[i]);
 			delete enemies[i];
 			enemies[i] = nullptr;
 			enemies.erase(enemies.begin() + i);
@@ -499,18 +838,129 @@ void GameScene::evaluate_player_collisions() {
 }
 
 void GameScene::set_enemy_pathfind(){
-    Node* player_node = node_map.get_closest_node(player.get_cuboid()->get_position());
+	// The walkable area is shrunk away from obstacles, so the player can stand in a wall's cell
+	Node* player_node = node_map.get_closest_open_node(player.get_cuboid()->get_position());
+	if (!player_node) { return; }
 
-    for (size_t i = 0; i < enemies.size(); ++i){
-        Enemy* enemy = enemies.at(i);
-        
-        if (enemy->get_path_counter() >= Enemy::PATH_REFRESH_TIME){
-			Node* enemy_node = node_map.get_closest_node(enemy->get_cuboid()->get_position());
-			auto path = node_map.a_star_pathfind(enemy_node, player_node);
-			enemy->set_shortest_path(path);
-			//pathfind_test(path);
-        }
-    }
+	const bool player_moved = player_node != last_player_node;
+	last_player_node = player_node;
+
+	// One field serves every enemy, and is only rebuilt once the player reaches another node
+	if (navigation_mode == NavigationModes::FLOW_FIELD) {
+		node_map.update_flow_field(player_node);
+		return;
+	}
+
+	const vec3 player_position = player.get_cuboid()->get_position();
+
+	// Only what is cheap and cannot wait is done here, every new search goes through the scheduler
+	for (size_t i = 0; i < enemies.size(); ++i) {
+		Enemy* enemy = enemies.at(i);
+
+		// The next leg is needed as soon as the enemy reaches the end of its current one
+		if ((navigation_mode == NavigationModes::HIERARCHICAL) && enemy->needs_next_segment()) {
+			const std::pair<Node*, Node*> segment = enemy->take_next_segment();
+			enemy->set_shortest_path(node_map.smooth_path(hierarchical_map.refine_segment(segment.first, segment.second)));
+		}
+
+		if ((navigation_mode == NavigationModes::A_STAR) || (navigation_mode == NavigationModes::JUMP_POINT)) { enemy->take_pending_path(); }
+
+		// Repairs cost about as much as the player's move changed, so are asked for as soon as it happens
+		const bool refresh_due = enemy->get_path_counter() >= Enemy::PATH_REFRESH_TIME;
+		if (refresh_due || (player_moved && (navigation_mode == NavigationModes::INCREMENTAL))) { ai_scheduler.request(enemy); }
+	}
+
+	// Nearest first, they are the ones whose paths the player can see go wrong
+	ai_scheduler.run(
+		[&player_position](Enemy* enemy) { return length_squared(enemy->get_cuboid()->get_position() - player_position); },
+		[this, player_node, &player_position](Enemy* enemy) {
+			Node* enemy_node = node_map.get_closest_open_node(enemy->get_cuboid()->get_position());
+
+			switch (navigation_mode) {
+				// Smoothing cuts the grid path's corners, so the closest node is often off it and a repair would become a new search
+				case (NavigationModes::INCREMENTAL) : {
+					Node* path_node = enemy->get_grid_path_node();
+					const std::vector<Node*> grid_path = enemy->get_incremental_path().find_path(node_map, path_node ? path_node : enemy_node, player_node);
+					enemy->set_grid_path(grid_path, node_map.smooth_path(grid_path));
+					break;
+				}
+				// Only the route is searched here, each leg is searched when the enemy reaches it
+				case (NavigationModes::HIERARCHICAL) : {
+					enemy->set_waypoints(hierarchical_map.find_abstract_path(enemy_node, player_node));
+					if (enemy->needs_next_segment()) {
+						const std::pair<Node*, Node*> segment = enemy->take_next_segment();
+						enemy->set_shortest_path(node_map.smooth_path(hierarchical_map.refine_segment(segment.first, segment.second)));
+					}
+					break;
+				}
+				case (NavigationModes::NAVIGATION_MESH) : {
+					enemy->set_path(navigation_mesh.find_path(enemy->get_cuboid()->get_position(), player_position));
+					break;
+				}
+				// Searched on the pool, the enemy keeps its old path until the new one is ready
+				default : {
+					if (!enemy->has_pending_path()) { enemy->set_pending_path(pathfinding_pool.request_path(enemy_node, player_node, navigation_mode == NavigationModes::JUMP_POINT)); }
+					break;
+				}
+			}
+
+			// Counted from when it was served, so enemies spawned together drift apart rather than all refreshing at once
+			enemy->reset_path_counter();
+		}
+	);
+}
+
+void GameScene::toggle_navigation() {
+	navigation_mode = (navigation_mode == NavigationModes::LAST) ? NavigationModes::FIRST : static_cast<EnumType>(navigation_mode + 1);
+
+	// Paths from the previous mode are dropped and every enemy queued to replan in the new one
+	for (size_t i = 0; i < enemies.size(); ++i) {
+		enemies.at(i)->set_shortest_path({});
+		enemies.at(i)->set_waypoints({});
+		enemies.at(i)->set_pending_path(std::future<std::vector<Node*>>());
+
+		if (navigation_mode == NavigationModes::FLOW_FIELD) { ai_scheduler.cancel(enemies.at(i)); }
+		else { ai_scheduler.request(enemies.at(i)); }
+	}
+
+	last_player_node = nullptr;
+
+	AttributeParser parser(GameConstants::OPTIONS());
+	parser.change_attribute(Options::NAVIGATION, get_navigation_name());
+}
+
+void GameScene::toggle_debug_wall() {
+	// The node a few nodes ahead of where the player is looking, never the player's own
+	vec3 forward = camera->get_front_vector();
+	forward.y = 0.0f;
+	if (length_squared(forward) < Constants::EPSILON_2) { return; }
+
+	const vec3 player_position = player.get_cuboid()->get_position();
+	Node* node = node_map.get_closest_node(player_position + (normalise(forward) * static_cast<float>(map_file.get_spacing() * 3)));
+	if (node == node_map.get_closest_node(player_position)) { return; }
+
+	// Pooled searches read the walls, so they must all have finished before one changes
+	pathfinding_pool.wait_until_idle();
+	node_map.set_wall(node, !node->get_is_wall());
+
+	// Searches are skipped between components, so those are brought up to date straight away
+	node_map.update_components();
+
+	// Incremental paths repair themselves and the hierarchical map rebuilds the clusters touched on their next search
+	if (navigation_mode == NavigationModes::FLOW_FIELD) { return; }
+	for (size_t i = 0; i < enemies.size(); ++i) { ai_scheduler.request(enemies.at(i)); }
+}
+
+std::string GameScene::get_navigation_name() const {
+	// As saved in the options file
+	switch (navigation_mode) {
+		case (NavigationModes::A_STAR) :			{ return "AStar"; }
+		case (NavigationModes::INCREMENTAL) :		{ return "Incremental"; }
+		case (NavigationModes::HIERARCHICAL) :		{ return "Hierarchical"; }
+		case (NavigationModes::JUMP_POINT) :		{ return "JumpPoint"; }
+		case (NavigationModes::NAVIGATION_MESH) :	{ return "NavigationMesh"; }
+		default :									{ return "FlowField"; }
+	}
 }
 
 void GameScene::pathfind_test(const std::vector<Node*>& path) {
@@ -556,6 +1006,7 @@ void GameScene::update_enemies() {
         if (enemy->get_is_done()){
             player.increment_score();
             
+			ai_scheduler.cancel(enemies[enemy_iter]);
             delete enemies[enemy_iter];
             enemies[enemy_iter] = nullptr;
             enemies.erase(enemies.begin() + enemy_iter);
@@ -564,7 +1015,8 @@ void GameScene::update_enemies() {
             continue;
         }
         
-		enemy->move_towards_closest_node(node_map);
+		if (navigation_mode == NavigationModes::FLOW_FIELD) { enemy->move_along_flow_field(node_map); }
+		else { enemy->move_along_path(); }
 		enemy->update(frame_time_delta);
     }
 }
@@ -594,6 +1046,11 @@ void GameScene::key_callback(GLFWwindow* window, int key, int scancode, int acti
             case (GLFW_KEY_F) : { player.toggle_first_person(); break; }
             case (GLFW_KEY_R) : { player.next_ability();		break; }
             case (GLFW_KEY_1) : { toggle = !toggle;				break; }
+            case (GLFW_KEY_2) : { toggle_depth_prepass();		break; }
+            case (GLFW_KEY_3) : { toggle_render_path();			break; }
+            case (GLFW_KEY_4) : { show_quality_overlay = !show_quality_overlay; break; }
+            case (GLFW_KEY_5) : { toggle_navigation();			break; }
+            case (GLFW_KEY_6) : { toggle_debug_wall();			break; }
 
 			// Pause menu
 			case (GLFW_KEY_ESCAPE) :	{ pause_activated = !pause_activated;			break; }
@@ -5,7 +5,18 @@
 #include "Player.hpp"
 #include "Enemy.hpp"
 #include "Map.hpp"
+#include "HierarchicalMap.hpp"
+#include "PathfindingPool.hpp"
+#include "NavigationMesh.hpp"
+#include "AIScheduler.hpp"
 #include "WindowWrapper.hpp"
+#include "DeferredRenderer.hpp"
+#include "Impostor.hpp"
+#include "StaticBatch.hpp"
+#include "IndirectRenderer.hpp"
+#include "PostProcess.hpp"
+#include "FrameTimer.hpp"
+#include "QualityGovernor.hpp"
 
 class PauseMenuChoices {
 public:
@@ -18,6 +29,20 @@ public:
 };
 
 
+class NavigationModes {
+public:
+	static const EnumType FLOW_FIELD = 0;	// One field from the player shared by every enemy
+	static const EnumType A_STAR = 1;		// A path each, searched again from scratch every refresh
+	static const EnumType INCREMENTAL = 2;	// A path each, repaired as the player moves
+	static const EnumType HIERARCHICAL = 3;	// A route each across map clusters, refined a leg at a time
+	static const EnumType JUMP_POINT = 4;	// As A_STAR, with Jump Point Search
+	static const EnumType NAVIGATION_MESH = 5;	// A path each over the terrain's navigation mesh, every refresh
+
+	static const EnumType FIRST = FLOW_FIELD;
+	static const EnumType LAST = NAVIGATION_MESH;
+};
+
+
 class GameReturnCodes : public ReturnCodes {
 public:
     static const EnumType MAIN_MENU = 4;
@@ -32,11 +57,6 @@ private:
 	const float player_square_dimension = 2.0f;
 	const float player_height = 5.0f;
 
-	// Map boundaries for node placement
-	const int x_lower_bound = -90;
-	const int x_upper_including = 94;
-	const int z_lower_bound = -90;
-	const int z_upper_including = 92;
 
 	// Map boundaries for collision detection
 	const float x_lower_collision = -87.0f;
@@ -44,6 +64,10 @@ private:
 	const float z_lower_collision = -88.5f;
 	const float z_upper_collision = 90.5f;
 
+	// Enemies start handing over to their impostor at impostor_distance and are fully replaced after the fade distance
+	const float impostor_distance = 60.0f;
+	const float impostor_fade_distance = 8.0f;
+
 public:
 	// Constructors and Destructors
 	GameScene(WindowWrapper* window, Camera* camera);
@@ -81,25 +105,46 @@ private:
 	// Private Member Variables
 	UInt framebuffer;
 	UInt cube_map;
+	UInt shadow_resolution = GameConstants::framebuffer_depth_resolution;
 
 	Player player;
 	SkyBox sky;
 	Model terrain;
+	StaticBatch terrain_batch;	// What is drawn, the model is only kept as its source
 	Cube sun;
 
 	std::vector<Enemy*> enemies;
+	MapFile map_file;	// The grid's extent, walls and where enemies spawn
 	Map node_map;
+	HierarchicalMap hierarchical_map;	// Built on its first search, after the walls are set up
+	PathfindingPool pathfinding_pool;	// A* and jump point paths, so the main thread never waits on them
+	NavigationMesh navigation_mesh;		// Built from the terrain, also marks the grid's walls
+	AIScheduler ai_scheduler;			// Enemies waiting to replan, served nearest first within a budget each frame
+	DeferredRenderer deferred_renderer;
+	PostProcess post_process;
+	FrameTimer frame_timer;
+	QualityGovernor quality_governor;	// Render scale and shadow quality, lowered when the GPU misses the frame time
+	Impostor enemy_impostor;
+	IndirectRenderer enemy_renderer;	// Only used when the context supports it
+	RenderQueue render_queue;			// Everything after the depth-tested opaque passes, transparent surfaces sorted
     
     Attribute<UInt>* player_score_getter;
 
 	bool pause_activated = false;
 	bool use_shadows = true;
+	bool use_depth_prepass = false;
+	bool use_deferred = false;
+	bool use_fxaa = false;
+	EnumType navigation_mode = NavigationModes::FLOW_FIELD;
+	Node* last_player_node = nullptr;
+	bool show_quality_overlay = false;
 
 	Text wave_text;
 	Text pause_menu_title;
 	Text resume_text;
 	Text exit_to_main_menu;
 	Text exit_game;
+	Text quality_text;
 
 	EnumType selected_option = PauseMenuChoices::FIRST;
 	float wave_text_timer = 0.0f;
@@ -111,15 +156,36 @@ private:
 
 	void render_framebuffer();
 	void setup_framebuffer();
+	void allocate_shadow_map();
+
+	void apply_quality_level();
+	void display_quality_overlay();
+	static std::vector<QualityLevel> get_quality_levels();
+
+	void render_depth_prepass(const Frustum& view_frustum);
+	void issue_occlusion_queries();
+	void toggle_depth_prepass();
+
+	void render_deferred(const mat4& vp, const mat4& projection, const RenderTarget* destination);
+	void submit_particles(const mat4& view, const mat4& projection);
+	void toggle_render_path();
+
+	void bake_enemy_impostor();
+	float get_enemy_fade_out(Enemy* enemy);
+	void render_distant_enemies(const SHADER_ID& id);
     
 	void spawn_wave();
     void spawn_enemy();
+	vec3 get_spawn_position();	// Somewhere open in one of the map's spawn zones, from where the player can be reached
     void set_enemy_pathfind();
+	void toggle_navigation();
+	void toggle_debug_wall();	// Through Map::set_wall, so the navigation modes' wall change handling can be seen working
+	std::string get_navigation_name() const;
     void evaluate_enemy_collisions();
 	void evaluate_player_collisions();
     void update_enemies();
     
-    std::vector<std::vector<Node*>> get_nodes();
+    void setup_nodes();
     void pathfind_test(const std::vector<Node*>& path);
     void select_node();
 
@@ -0,0 +1,327 @@
+#include "HierarchicalMap.hpp"
+#include <algorithm>
+
+const int HierarchicalMap::INFINITE_COST;
+const UInt HierarchicalMap::NO_PARENT;
+
+
+HierarchicalMap::HierarchicalMap(Map& map, const size_t& cluster_size) :
+map(map),
+cluster_size(cluster_size),
+clusters_x((map.get_node_map_size() + cluster_size - 1) / cluster_size),
+clusters_y((map.get_node_column_size(0) + cluster_size - 1) / cluster_size) {
+
+	clusters.resize(clusters_x * clusters_y);
+	entrance_slots.assign(map.get_node_count(), -1);
+	search_nodes.assign(map.get_node_count(), { 0, NO_PARENT, 0, false });
+}
+
+std::vector<Node*> HierarchicalMap::find_abstract_path(Node* start_node, Node* goal_node) {
+	if (start_node->get_is_wall() || goal_node->get_is_wall()) { return std::vector<Node*>(); }
+	if (!map.may_reach(map.get_index(start_node), map.get_index(goal_node))) { return std::vector<Node*>(); }
+
+	update();
+
+	const size_t start = map.get_index(start_node);
+	const size_t goal = map.get_index(goal_node);
+	const size_t start_cluster = get_cluster_of(start);
+	const size_t goal_cluster = get_cluster_of(goal);
+
+	// The goal joins the graph through the entrances of its cluster, and the start too if they share one
+	find_cluster_distances(goal);
+	const Cluster& goal_cluster_data = clusters.at(goal_cluster);
+	std::vector<int> goal_distances(goal_cluster_data.entrances.size());
+	for (size_t slot = 0; slot < goal_cluster_data.entrances.size(); ++slot) {
+		goal_distances[slot] = local_distances[get_local_index(goal_cluster_data.entrances[slot])];
+	}
+	const int direct_distance = (start_cluster == goal_cluster) ? local_distances[get_local_index(start)] : INFINITE_COST;
+
+	if (++search_number == 0) {
+		for (size_t iter = 0; iter < search_nodes.size(); ++iter) { search_nodes[iter].search_number = 0; }
+		search_number = 1;
+	}
+
+	open_set.clear();
+	get_search_node(start).g = 0;
+	open_set.push_back({ map.heuristic_estimate(start, goal), map.heuristic_estimate(start, goal), static_cast<UInt>(start) });
+
+	while (!open_set.empty()) {
+		std::pop_heap(open_set.begin(), open_set.end(), is_worse_entry);
+		const OpenEntry entry = open_set.back();
+		open_set.pop_back();
+
+		SearchNode& current = search_nodes[entry.index];
+		if (current.closed || ((entry.f - entry.h) != current.g)) { continue; }
+
+		if (entry.index == goal) {
+			std::vector<Node*> waypoints;
+			for (UInt iter = entry.index; iter != NO_PARENT; iter = search_nodes[iter].parent) {
+				waypoints.push_back(map.get_node_at(iter));
+			}
+
+			std::reverse(waypoints.begin(), waypoints.end());
+			return waypoints;
+		}
+
+		current.closed = true;
+
+		const size_t current_cluster = get_cluster_of(entry.index);
+		const Cluster& cluster = clusters.at(current_cluster);
+		const int slot = entrance_slots[entry.index];
+
+		// The start reaches its cluster's entrances (and the goal, if it is there) by a search within the cluster
+		if (entry.index == start) {
+			find_cluster_distances(start);
+			for (size_t other = 0; other < cluster.entrances.size(); ++other) {
+				relax(start, cluster.entrances[other], local_distances[get_local_index(cluster.entrances[other])], goal);
+			}
+
+			if (direct_distance < INFINITE_COST) { relax(start, goal, direct_distance, goal); }
+		}
+
+		if (slot < 0) { continue; }
+
+		const size_t entrance_total = cluster.entrances.size();
+		for (size_t other = 0; other < entrance_total; ++other) {
+			relax(entry.index, cluster.entrances[other], cluster.distances[(static_cast<size_t>(slot) * entrance_total) + other], goal);
+		}
+
+		for (size_t link_iter = 0; link_iter < cluster.links.size(); ++link_iter) {
+			const std::pair<UInt, UInt>& link = cluster.links[link_iter];
+			if (link.first == static_cast<UInt>(slot)) { relax(entry.index, link.second, map.movement_cost(entry.index, link.second), goal); }
+		}
+
+		if (current_cluster == goal_cluster) { relax(entry.index, goal, goal_distances[slot], goal); }
+	}
+
+	return std::vector<Node*>();
+}
+
+std::vector<Node*> HierarchicalMap::refine_segment(Node* from_node, Node* to_node) {
+	// Legs either stay in one cluster or cross into the next, so the search never needs more than the two
+	const GridBounds from_bounds = get_cluster_bounds(get_cluster_of(map.get_index(from_node)));
+	const GridBounds to_bounds = get_cluster_bounds(get_cluster_of(map.get_index(to_node)));
+
+	const GridBounds bounds = {
+		std::min(from_bounds.min_x, to_bounds.min_x),
+		std::min(from_bounds.min_y, to_bounds.min_y),
+		std::max(from_bounds.max_x, to_bounds.max_x),
+		std::max(from_bounds.max_y, to_bounds.max_y)
+	};
+
+	return map.a_star_pathfind(from_node, to_node, &bounds);
+}
+
+void HierarchicalMap::update() {
+	if (!built) {
+		for (size_t cluster_x = 0; cluster_x < clusters_x; ++cluster_x) {
+			for (size_t cluster_y = 0; cluster_y < clusters_y; ++cluster_y) { build_cluster(cluster_x, cluster_y); }
+		}
+
+		built = true;
+		wall_changes_seen = map.get_wall_change_count();
+		return;
+	}
+
+	std::vector<size_t> dirty_clusters;
+
+	for (; wall_changes_seen < map.get_wall_change_count(); ++wall_changes_seen) {
+		const size_t changed = map.get_wall_change(wall_changes_seen);
+		const size_t x = map.get_column(changed);
+		const size_t y = map.get_row(changed);
+		const size_t cluster_x = x / cluster_size;
+		const size_t cluster_y = y / cluster_size;
+
+		dirty_clusters.push_back(get_cluster_index(cluster_x, cluster_y));
+
+		// Entrances are shared with the cluster across a border, so changes on one rebuild both sides
+		if (((x % cluster_size) == 0) && (cluster_x > 0))									{ dirty_clusters.push_back(get_cluster_index(cluster_x - 1, cluster_y)); }
+		if (((x % cluster_size) == (cluster_size - 1)) && ((cluster_x + 1) < clusters_x))	{ dirty_clusters.push_back(get_cluster_index(cluster_x + 1, cluster_y)); }
+		if (((y % cluster_size) == 0) && (cluster_y > 0))									{ dirty_clusters.push_back(get_cluster_index(cluster_x, cluster_y - 1)); }
+		if (((y % cluster_size) == (cluster_size - 1)) && ((cluster_y + 1) < clusters_y))	{ dirty_clusters.push_back(get_cluster_index(cluster_x, cluster_y + 1)); }
+	}
+
+	std::sort(dirty_clusters.begin(), dirty_clusters.end());
+	dirty_clusters.erase(std::unique(dirty_clusters.begin(), dirty_clusters.end()), dirty_clusters.end());
+
+	for (size_t iter = 0; iter < dirty_clusters.size(); ++iter) {
+		build_cluster(dirty_clusters[iter] / clusters_y, dirty_clusters[iter] % clusters_y);
+	}
+}
+
+void HierarchicalMap::build_cluster(const size_t& cluster_x, const size_t& cluster_y) {
+	Cluster& cluster = clusters.at(get_cluster_index(cluster_x, cluster_y));
+
+	for (size_t iter = 0; iter < cluster.entrances.size(); ++iter) { entrance_slots[cluster.entrances[iter]] = -1; }
+	entrance_count -= cluster.entrances.size();
+
+	cluster.entrances.clear();
+	cluster.links.clear();
+
+	// Transitions are found the same way from either side of a border, so neighbouring clusters always agree
+	std::vector<std::pair<UInt, UInt>> transitions;
+	std::vector<std::pair<UInt, UInt>> facing;
+
+	find_transitions(cluster_x, cluster_y, true, transitions);
+	find_transitions(cluster_x, cluster_y, false, transitions);
+	for (size_t iter = 0; iter < transitions.size(); ++iter) { facing.push_back(transitions[iter]); }
+
+	transitions.clear();
+	if (cluster_x > 0) { find_transitions(cluster_x - 1, cluster_y, true, transitions); }
+	if (cluster_y > 0) { find_transitions(cluster_x, cluster_y - 1, false, transitions); }
+	for (size_t iter = 0; iter < transitions.size(); ++iter) { facing.push_back(std::make_pair(transitions[iter].second, transitions[iter].first)); }
+
+	for (size_t iter = 0; iter < facing.size(); ++iter) {
+		const UInt entrance = facing[iter].first;
+
+		// Nodes in a cluster's corner can be an entrance on two borders
+		if (entrance_slots[entrance] < 0) {
+			entrance_slots[entrance] = static_cast<int>(cluster.entrances.size());
+			cluster.entrances.push_back(entrance);
+		}
+
+		cluster.links.push_back(std::make_pair(static_cast<UInt>(entrance_slots[entrance]), facing[iter].second));
+	}
+
+	entrance_count += cluster.entrances.size();
+
+	const size_t entrance_total = cluster.entrances.size();
+	cluster.distances.assign(entrance_total * entrance_total, INFINITE_COST);
+
+	for (size_t from = 0; from < entrance_total; ++from) {
+		find_cluster_distances(cluster.entrances[from]);
+
+		for (size_t to = 0; to < entrance_total; ++to) {
+			cluster.distances[(from * entrance_total) + to] = local_distances[get_local_index(cluster.entrances[to])];
+		}
+	}
+}
+
+void HierarchicalMap::find_transitions(const size_t& cluster_x, const size_t& cluster_y, const bool along_x, std::vector<std::pair<UInt, UInt>>& transitions) const {
+	if (along_x ? ((cluster_x + 1) >= clusters_x) : ((cluster_y + 1) >= clusters_y)) { return; }
+
+	const GridBounds bounds = get_cluster_bounds(get_cluster_index(cluster_x, cluster_y));
+
+	// Walked along the shared border, the line of nodes inside the cluster and the line facing it
+	const size_t border_length = along_x ? (bounds.max_y - bounds.min_y + 1) : (bounds.max_x - bounds.min_x + 1);
+	const size_t long_opening = 6;
+	size_t run_start = 0;
+	size_t run_length = 0;
+
+	for (size_t step = 0; step <= border_length; ++step) {
+		bool open = false;
+		size_t inside = 0;
+		size_t outside = 0;
+
+		if (step < border_length) {
+			inside = along_x ? map.get_index(bounds.max_x, bounds.min_y + step) : map.get_index(bounds.min_x + step, bounds.max_y);
+			outside = along_x ? map.get_index(bounds.max_x + 1, bounds.min_y + step) : map.get_index(bounds.min_x + step, bounds.max_y + 1);
+			open = !map.get_node_at(inside)->get_is_wall() && !map.get_node_at(outside)->get_is_wall();
+		}
+
+		if (open) {
+			if (run_length == 0) { run_start = step; }
+			++run_length;
+			continue;
+		}
+
+		if (run_length == 0) { continue; }
+
+		std::vector<size_t> chosen;
+		if (run_length < long_opening) { chosen.push_back(run_start + (run_length / 2)); }
+		else {
+			chosen.push_back(run_start);
+			chosen.push_back(run_start + run_length - 1);
+		}
+
+		for (size_t iter = 0; iter < chosen.size(); ++iter) {
+			const size_t offset = chosen[iter];
+			const size_t chosen_inside = along_x ? map.get_index(bounds.max_x, bounds.min_y + offset) : map.get_index(bounds.min_x + offset, bounds.max_y);
+			const size_t chosen_outside = along_x ? map.get_index(bounds.max_x + 1, bounds.min_y + offset) : map.get_index(bounds.min_x + offset, bounds.max_y + 1);
+
+			transitions.push_back(std::make_pair(static_cast<UInt>(chosen_inside), static_cast<UInt>(chosen_outside)));
+		}
+
+		run_length = 0;
+	}
+}
+
+void HierarchicalMap::find_cluster_distances(const size_t& from) {
+	const GridBounds bounds = get_cluster_bounds(get_cluster_of(from));
+
+	local_distances.assign(cluster_size * cluster_size, INFINITE_COST);
+	frontier.clear();
+
+	local_distances[get_local_index(from)] = 0;
+	frontier.push_back(static_cast<UInt>(from));
+
+	for (size_t frontier_iter = 0; frontier_iter < frontier.size(); ++frontier_iter) {
+		const size_t current = frontier[frontier_iter];
+		const int current_distance = local_distances[get_local_index(current)];
+
+		size_t neighbours[4];
+		const size_t neighbour_count = map.get_neighbours(current, neighbours);
+
+		for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+			const size_t neighbour = neighbours[neighbour_iter];
+			if (!bounds.contains(map.get_column(neighbour), map.get_row(neighbour)) || map.get_node_at(neighbour)->get_is_wall()) { continue; }
+
+			int& distance = local_distances[get_local_index(neighbour)];
+			if (distance < INFINITE_COST) { continue; }
+
+			distance = current_distance + map.movement_cost(current, neighbour);
+			frontier.push_back(static_cast<UInt>(neighbour));
+		}
+	}
+}
+
+size_t HierarchicalMap::get_cluster_of(const size_t& node) const {
+	return get_cluster_index(map.get_column(node) / cluster_size, map.get_row(node) / cluster_size);
+}
+
+GridBounds HierarchicalMap::get_cluster_bounds(const size_t& cluster) const {
+	const size_t cluster_x = cluster / clusters_y;
+	const size_t cluster_y = cluster % clusters_y;
+
+	// Clusters along the far edges are cut short where the grid ends
+	return {
+		cluster_x * cluster_size,
+		cluster_y * cluster_size,
+		std::min(((cluster_x + 1) * cluster_size) - 1, map.get_node_map_size() - 1),
+		std::min(((cluster_y + 1) * cluster_size) - 1, map.get_node_column_size(0) - 1)
+	};
+}
+
+size_t HierarchicalMap::get_local_index(const size_t& node) const {
+	return ((map.get_column(node) % cluster_size) * cluster_size) + (map.get_row(node) % cluster_size);
+}
+
+HierarchicalMap::SearchNode& HierarchicalMap::get_search_node(const size_t& index) {
+	SearchNode& search_node = search_nodes[index];
+
+	if (search_node.search_number != search_number) {
+		search_node = { INFINITE_COST, NO_PARENT, search_number, false };
+	}
+
+	return search_node;
+}
+
+void HierarchicalMap::relax(const size_t& from, const size_t& to, const int& cost, const size_t& goal) {
+	if (cost >= INFINITE_COST) { return; }
+
+	SearchNode& target = get_search_node(to);
+	const int test_g = search_nodes[from].g + cost;
+	if (target.closed || (test_g >= target.g)) { return; }
+
+	target.g = test_g;
+	target.parent = static_cast<UInt>(from);
+
+	const int h = map.heuristic_estimate(to, goal);
+	open_set.push_back({ test_g + h, h, static_cast<UInt>(to) });
+	std::push_heap(open_set.begin(), open_set.end(), is_worse_entry);
+}
+
+bool HierarchicalMap::is_worse_entry(const OpenEntry& left, const OpenEntry& right) {
+	if (left.f != right.f) { return left.f > right.f; }
+	return left.h > right.h;
+}
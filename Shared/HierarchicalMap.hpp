@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Map.hpp"
+
+
+class HierarchicalMap {
+	/*
+	A coarse graph over a Map for searching long distances (HPA*)
+
+	The grid is split into square clusters. Where open nodes face each other across a cluster's
+	border they form entrances (one in the middle of a short opening, one at either end of a long
+	one), and the distances between a cluster's entrances are found once, without leaving it.
+	A search then only visits entrances, plus the start and goal which are linked to the
+	entrances of their own clusters. Each leg of the route it returns stays within a cluster or
+	crosses a single border, so it can be refined into grid steps on its own, when it is reached.
+
+	Wall changes recorded by the map are picked up before each search, rebuilding the clusters
+	they are in and, for walls on a border, the cluster across it
+	*/
+
+public:
+	HierarchicalMap(Map& map, const size_t& cluster_size = 10);
+
+	HierarchicalMap(const HierarchicalMap& other) = delete;
+	void operator=(const HierarchicalMap& other) = delete;
+
+	// The start, the entrances passed through and the goal, or empty when the goal cannot be reached
+	std::vector<Node*> find_abstract_path(Node* start_node, Node* goal_node);
+
+	// The grid path between two neighbouring nodes of an abstract path, both included
+	std::vector<Node*> refine_segment(Node* from_node, Node* to_node);
+
+	inline size_t get_entrance_count() const { return entrance_count; }
+
+private:
+	static const int INFINITE_COST = INT_MAX / 2;
+	static const UInt NO_PARENT = UINT_MAX;
+
+	struct Cluster {
+		std::vector<UInt> entrances;					// Node indices
+		std::vector<std::pair<UInt, UInt>> links;		// Entrance slot and the node it faces across the border
+		std::vector<int> distances;						// Between entrance slots, entrances.size() squared
+	};
+
+	struct SearchNode {
+		int g;
+		UInt parent;
+		UInt search_number;
+		bool closed;
+	};
+
+	struct OpenEntry {
+		int f;
+		int h;
+		UInt index;
+	};
+
+	Map& map;
+	size_t cluster_size;
+	size_t clusters_x;
+	size_t clusters_y;
+
+	std::vector<Cluster> clusters;		// Column major, like the map's nodes
+	std::vector<int> entrance_slots;	// Per node, its slot in its cluster's entrances or -1
+	size_t entrance_count = 0;
+
+	bool built = false;
+	size_t wall_changes_seen = 0;
+
+	std::vector<SearchNode> search_nodes;
+	std::vector<OpenEntry> open_set;
+	UInt search_number = 0;
+
+	std::vector<UInt> frontier;			// Shared by the breadth first searches within a cluster
+	std::vector<int> local_distances;
+
+	void update();
+	void build_cluster(const size_t& cluster_x, const size_t& cluster_y);
+
+	// Pairs of facing nodes chosen as entrances on the border between a cluster and the next one along x or y
+	void find_transitions(const size_t& cluster_x, const size_t& cluster_y, const bool along_x, std::vector<std::pair<UInt, UInt>>& transitions) const;
+
+	// Fills local_distances with steps from the node to every node of its cluster, indexed by get_local_index()
+	void find_cluster_distances(const size_t& from);
+
+	inline size_t get_cluster_index(const size_t& cluster_x, const size_t& cluster_y) const { return (cluster_x * clusters_y) + cluster_y; }
+	size_t get_cluster_of(const size_t& node) const;
+	GridBounds get_cluster_bounds(const size_t& cluster) const;
+	size_t get_local_index(const size_t& node) const;
+
+	SearchNode& get_search_node(const size_t& index);
+	void relax(const size_t& from, const size_t& to, const int& cost, const size_t& goal);
+
+	static bool is_worse_entry(const OpenEntry& left, const OpenEntry& right);
+};
@@ -0,0 +1,203 @@
+#include "IncrementalPath.hpp"
+#include <algorithm>
+
+const int IncrementalPath::INFINITE_COST;
+const UInt IncrementalPath::NO_NODE;
+
+
+std::vector<Node*> IncrementalPath::find_path(Map& map, Node* start_node, Node* goal_node) {
+	if (start_node->get_is_wall() || goal_node->get_is_wall()) { return std::vector<Node*>(); }
+
+	const size_t start = map.get_index(start_node);
+	const size_t goal_index = map.get_index(goal_node);
+
+	// A path that no longer passes through the agent cannot be shortened to start from it
+	const bool on_path = std::find(path.begin(), path.end(), start_node) != path.end();
+
+	if ((g.size() != map.get_node_count()) || (start != root && !on_path)) {
+		start_search(map, start, goal_index);
+
+	} else {
+		apply_wall_changes(map);
+
+		if (goal_index != goal) {
+			key_offset += map.heuristic_estimate(goal, goal_index);
+			goal = static_cast<UInt>(goal_index);
+		}
+	}
+
+	compute_shortest_path(map);
+
+	// Among paths of equal length the one kept may not pass through the agent, when it does not the agent becomes the root
+	if (!extract_path(map, start) && (start != root)) {
+		start_search(map, start, goal_index);
+		compute_shortest_path(map);
+		extract_path(map, start);
+	}
+
+	std::vector<Node*>::iterator start_iter = std::find(path.begin(), path.end(), start_node);
+	if (start_iter == path.end()) { return std::vector<Node*>(); }
+
+	return std::vector<Node*>(start_iter, path.end());
+}
+
+void IncrementalPath::start_search(Map& map, const size_t& new_root, const size_t& new_goal) {
+	g.assign(map.get_node_count(), INFINITE_COST);
+	rhs.assign(map.get_node_count(), INFINITE_COST);
+	queue.clear();
+	path.clear();
+
+	root = static_cast<UInt>(new_root);
+	goal = static_cast<UInt>(new_goal);
+	key_offset = 0;
+	wall_changes_seen = map.get_wall_change_count();
+
+	rhs[root] = 0;
+	push(root, calculate_key(map, root));
+}
+
+void IncrementalPath::apply_wall_changes(Map& map) {
+	for (; wall_changes_seen < map.get_wall_change_count(); ++wall_changes_seen) {
+		const size_t changed = map.get_wall_change(wall_changes_seen);
+
+		// Moving into or out of the node costs something different now, which affects it and its neighbours
+		update_node(map, changed);
+
+		size_t neighbours[4];
+		const size_t neighbour_count = map.get_neighbours(changed, neighbours);
+		for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+			update_node(map, neighbours[neighbour_iter]);
+		}
+	}
+}
+
+void IncrementalPath::compute_shortest_path(Map& map) {
+	while (true) {
+		while (!queue.empty() && (g[queue.front().index] == rhs[queue.front().index])) {
+			std::pop_heap(queue.begin(), queue.end(), is_worse_entry);
+			queue.pop_back();
+		}
+
+		if (queue.empty()) { return; }
+		if (!is_key_less(queue.front().key, calculate_key(map, goal)) && (g[goal] == rhs[goal])) { return; }
+
+		std::pop_heap(queue.begin(), queue.end(), is_worse_entry);
+		const QueueEntry entry = queue.back();
+		queue.pop_back();
+
+		const size_t current = entry.index;
+		const Key new_key = calculate_key(map, current);
+
+		// Queued before the goal last moved, so its key is out of date
+		if (is_key_less(entry.key, new_key)) {
+			push(current, new_key);
+			continue;
+		}
+
+		size_t neighbours[4];
+		const size_t neighbour_count = map.get_neighbours(current, neighbours);
+
+		if (g[current] > rhs[current]) {
+			g[current] = rhs[current];
+
+		} else {
+			g[current] = INFINITE_COST;
+			update_node(map, current);
+		}
+
+		for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+			update_node(map, neighbours[neighbour_iter]);
+		}
+	}
+}
+
+bool IncrementalPath::extract_path(Map& map, const size_t& start) {
+	path.clear();
+	if (g[goal] >= INFINITE_COST) { return false; }
+
+	// Walked back from the goal, stepping to whichever neighbour is closest to the root
+	const Node* start_node = map.get_node_at(start);
+	size_t current = goal;
+	path.push_back(map.get_node_at(current));
+
+	while ((current != root) && (path.size() <= map.get_node_count())) {
+		size_t neighbours[4];
+		const size_t neighbour_count = map.get_neighbours(current, neighbours);
+
+		size_t best = current;
+		int best_cost = INFINITE_COST;
+		int best_start_distance = INFINITE_COST;
+
+		for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+			const size_t neighbour = neighbours[neighbour_iter];
+			if (map.get_node_at(neighbour)->get_is_wall() || (g[neighbour] >= INFINITE_COST)) { continue; }
+
+			// Ties go to the neighbour nearest the agent, which keeps it on the path while it walks it
+			const int cost = g[neighbour] + map.movement_cost(neighbour, current);
+			const int start_distance = map.heuristic_estimate(neighbour, start);
+
+			if ((cost < best_cost) || ((cost == best_cost) && (start_distance < best_start_distance))) {
+				best = neighbour;
+				best_cost = cost;
+				best_start_distance = start_distance;
+			}
+		}
+
+		if (best == current) { break; }
+
+		current = best;
+		path.push_back(map.get_node_at(current));
+	}
+
+	if (current != root) {
+		path.clear();
+		return false;
+	}
+
+	std::reverse(path.begin(), path.end());
+	return std::find(path.begin(), path.end(), start_node) != path.end();
+}
+
+void IncrementalPath::update_node(Map& map, const size_t& index) {
+	if (index != root) {
+		int lookahead = INFINITE_COST;
+
+		if (!map.get_node_at(index)->get_is_wall()) {
+			size_t neighbours[4];
+			const size_t neighbour_count = map.get_neighbours(index, neighbours);
+
+			for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+				const size_t neighbour = neighbours[neighbour_iter];
+				if (map.get_node_at(neighbour)->get_is_wall()) { continue; }
+
+				lookahead = std::min(lookahead, g[neighbour] + map.movement_cost(neighbour, index));
+			}
+		}
+
+		rhs[index] = std::min(lookahead, static_cast<int>(INFINITE_COST));
+	}
+
+	if (g[index] != rhs[index]) { push(index, calculate_key(map, index)); }
+}
+
+void IncrementalPath::push(const size_t& index, const Key& key) {
+	queue.push_back({ key, static_cast<UInt>(index) });
+	std::push_heap(queue.begin(), queue.end(), is_worse_entry);
+}
+
+IncrementalPath::Key IncrementalPath::calculate_key(const Map& map, const size_t& index) const {
+	const int cost = std::min(g[index], rhs[index]);
+	if (cost >= INFINITE_COST) { return { INFINITE_COST, INFINITE_COST }; }
+
+	return { cost + map.heuristic_estimate(index, goal) + key_offset, cost };
+}
+
+bool IncrementalPath::is_key_less(const Key& left, const Key& right) {
+	if (left.primary != right.primary) { return left.primary < right.primary; }
+	return left.secondary < right.secondary;
+}
+
+bool IncrementalPath::is_worse_entry(const QueueEntry& left, const QueueEntry& right) {
+	// The heap keeps its greatest element first, so the smallest key must compare greatest
+	return is_key_less(right.key, left.key);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Map.hpp"
+
+
+class IncrementalPath {
+	/*
+	One agent's shortest path to a moving goal, repaired between searches rather than redone (D* Lite)
+
+	The search is rooted at the agent's node and works outward towards the goal. Each node keeps
+	its distance from the root (g) and a one step lookahead of it (rhs), nodes where the two differ
+	are queued. When the goal moves, queued keys are offset rather than recomputed, and when walls
+	change only the changed nodes and their neighbours are queued again, so a replan expands the
+	nodes whose distance actually changed instead of the whole search.
+
+	The root is kept while the agent walks the path, since the rest of a shortest path is itself
+	shortest. Once the agent is no longer on the path to the goal the search is started again from
+	its new node.
+
+	Holds two values per map node, so is meant for a handful of agents on one map
+	*/
+
+public:
+	IncrementalPath() {}
+
+	IncrementalPath(const IncrementalPath& other) = delete;
+	void operator=(const IncrementalPath& other) = delete;
+
+	// The path from start to goal, both included, or empty when the goal cannot be reached
+	std::vector<Node*> find_path(Map& map, Node* start_node, Node* goal_node);
+
+private:
+	static const int INFINITE_COST = INT_MAX / 2;	// Leaves room to add a step without overflowing
+	static const UInt NO_NODE = UINT_MAX;
+
+	struct Key {
+		int primary;
+		int secondary;
+	};
+
+	struct QueueEntry {
+		Key key;
+		UInt index;
+	};
+
+	std::vector<int> g;
+	std::vector<int> rhs;
+	std::vector<QueueEntry> queue;	// Binary heap, entries for nodes that have since become consistent are skipped
+
+	UInt root = NO_NODE;
+	UInt goal = NO_NODE;
+	int key_offset = 0;				// Grows by how far the goal has moved since the root was set
+	size_t wall_changes_seen = 0;
+
+	std::vector<Node*> path;		// From the root, kept to tell whether the agent is still on it
+
+	void start_search(Map& map, const size_t& new_root, const size_t& new_goal);
+	void apply_wall_changes(Map& map);
+	void compute_shortest_path(Map& map);
+	bool extract_path(Map& map, const size_t& start);
+
+	void update_node(Map& map, const size_t& index);
+	void push(const size_t& index, const Key& key);
+	Key calculate_key(const Map& map, const size_t& index) const;
+
+	static bool is_key_less(const Key& left, const Key& right);
+	static bool is_worse_entry(const QueueEntry& left, const QueueEntry& right);
+};
@@ -1,197 +1,488 @@
 #include "Map.hpp"
 #include <algorithm>
 
+const UInt Map::NO_PARENT;
 
-Map::~Map(){
-    for (size_t i = 0; i < node_map.size(); ++i){
-        for (size_t j = 0; j < node_map.at(i).size(); ++j){
-			delete node_map[i][j];
-			node_map[i][j] = nullptr;
-        }
-        
-        node_map[i].clear();
-    }
-    
-    node_map.clear();
+
+Map::Map(const int& x_lower_bound, const int& x_upper_bound, const int& z_lower_bound, const int& z_upper_bound, const int& spacing) :
+width(static_cast<size_t>((x_upper_bound - x_lower_bound) / spacing) + 1),
+depth(static_cast<size_t>((z_upper_bound - z_lower_bound) / spacing) + 1),
+x_origin(x_lower_bound),
+z_origin(z_lower_bound),
+spacing(spacing) {
+
+	nodes.reserve(width * depth);
+
+	for (size_t x = 0; x < width; ++x) {
+		for (size_t y = 0; y < depth; ++y) {
+			nodes.push_back(Node(x_origin + static_cast<int>(x) * spacing, z_origin + static_cast<int>(y) * spacing));
+		}
+	}
+
+	flow_next.assign(nodes.size(), NO_PARENT);
+}
+
+Map::Map(const MapFile& file) : Map(file.get_x_lower_bound(), file.get_x_upper_bound(), file.get_z_lower_bound(), file.get_z_upper_bound(), file.get_spacing()) {
+	for (size_t x = 0; x < width; ++x) {
+		for (size_t y = 0; y < depth; ++y) { nodes[get_index(x, y)].set_wall(file.is_wall(x, y)); }
+	}
+
+	if (file.has_components()) {
+		components = file.get_components();
+		components_current = true;
+
+	} else {
+		update_components();
+	}
 }
 
-std::vector<Node*> Map::a_star_pathfind(Node* start_node, Node* end_node){
+std::vector<Node*> Map::a_star_pathfind(Node* start_node, Node* end_node, const GridBounds* bounds){
+	return a_star_pathfind(search_context, start_node, end_node, bounds);
+}
+
+std::vector<Node*> Map::a_star_pathfind(SearchContext& context, Node* start_node, Node* end_node, const GridBounds* bounds) {
     if (start_node->get_is_wall() || end_node->get_is_wall()) { return std::vector<Node*>(); }
-    
-    this->reset();
-    
-	NodeQueue open_set(start_node);
-	std::vector<Node*> closed_set;
-        
-    start_node->set_g(0);
-    start_node->set_h(heuristic_estimate(start_node, end_node));
-    
-    while (!open_set.empty()) {
-		open_set.manual_sort();
-		Node* current = open_set.at(0);
-        
-        if (current->get_is_wall()){
-            closed_set.push_back(current);
-			open_set.erase(std::remove(open_set.begin(), open_set.end(), current), open_set.end());
-			continue;
-        }
-        
-        if (current == end_node) {
-            return reconstruct_path(current);
-        }
-        
-		open_set.erase(std::remove(open_set.begin(), open_set.end(), current), open_set.end());
-        closed_set.push_back(current);
-        
-        std::vector<Node*> current_neighbours = get_node_neighbours(current);
-        for (size_t i = 0; i < current_neighbours.size(); ++i){
-            Node* neighbour = current_neighbours.at(i);
-            
-            if (std::find(closed_set.begin(), closed_set.end(), neighbour) != closed_set.end()){
-                // Neighbour is in closed set - ignore it
-                continue;
-            }
-
-			if (std::find(open_set.begin(), open_set.end(), neighbour) == open_set.end()){
-                neighbour->set_h(heuristic_estimate(neighbour, end_node));
-				open_set.push_back(neighbour);
-            }
-            
-			int test_g = current->g + movement_cost(current, neighbour);
-            if (test_g >= neighbour->g){
-                continue;
-            }
-            
-            neighbour->set_parent(current);
-            neighbour->set_g(test_g);
+	if (!may_reach(get_index(start_node), get_index(end_node))) { return std::vector<Node*>(); }
+
+	begin_search(context);
+
+	const size_t start_index = get_index(start_node);
+	const size_t end_index = get_index(end_node);
+
+	get_search_node(context, start_index).g = 0;
+	push_open(context, start_index, 0, heuristic_estimate(start_index, end_index));
+
+    while (!context.open_set.empty()) {
+		std::pop_heap(context.open_set.begin(), context.open_set.end(), is_worse_entry);
+		const OpenEntry entry = context.open_set.back();
+		context.open_set.pop_back();
+
+		SearchNode& current = context.search_nodes.at(entry.index);
+
+		// Entries left behind when a cheaper route to the node was found
+		if (current.closed || ((entry.f - entry.h) != current.g)) { continue; }
+
+        if (entry.index == end_index) {
+            return reconstruct_path(context, end_index);
         }
+
+		current.closed = true;
+
+		size_t neighbours[4];
+		const size_t neighbour_count = get_neighbours(entry.index, neighbours);
+
+		for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+			const size_t neighbour_index = neighbours[neighbour_iter];
+			if (nodes[neighbour_index].get_is_wall()) { continue; }
+			if (bounds && !bounds->contains(get_column(neighbour_index), get_row(neighbour_index))) { continue; }
+
+			SearchNode& neighbour = get_search_node(context, neighbour_index);
+			if (neighbour.closed) { continue; }
+
+			const int test_g = current.g + movement_cost(entry.index, neighbour_index);
+			if (test_g >= neighbour.g) { continue; }
+
+			neighbour.parent = entry.index;
+			neighbour.g = test_g;
+			push_open(context, neighbour_index, test_g, heuristic_estimate(neighbour_index, end_index));
+		}
     }
-    
+
     return std::vector<Node*>();
 }
 
-int Map::movement_cost(Node* start, Node* end) {
+std::vector<Node*> Map::jump_point_pathfind(Node* start_node, Node* end_node) {
+	return jump_point_pathfind(search_context, start_node, end_node);
+}
+
+std::vector<Node*> Map::jump_point_pathfind(SearchContext& context, Node* start_node, Node* end_node) {
+	if (start_node->get_is_wall() || end_node->get_is_wall()) { return std::vector<Node*>(); }
+	if (!may_reach(get_index(start_node), get_index(end_node))) { return std::vector<Node*>(); }
+
+	begin_search(context);
+
+	const size_t start_index = get_index(start_node);
+	const size_t end_index = get_index(end_node);
+
+	get_search_node(context, start_index).g = 0;
+	push_open(context, start_index, 0, heuristic_estimate(start_index, end_index));
+
+	while (!context.open_set.empty()) {
+		std::pop_heap(context.open_set.begin(), context.open_set.end(), is_worse_entry);
+		const OpenEntry entry = context.open_set.back();
+		context.open_set.pop_back();
+
+		SearchNode& current = context.search_nodes.at(entry.index);
+		if (current.closed || ((entry.f - entry.h) != current.g)) { continue; }
+
+		if (entry.index == end_index) {
+			std::vector<Node*> finished_path;
+
+			// Parents are jump points, the nodes between them lie on a straight line
+			for (UInt iter = entry.index; iter != NO_PARENT; iter = context.search_nodes[iter].parent) {
+				const UInt parent = context.search_nodes[iter].parent;
+				finished_path.push_back(&nodes[iter]);
+				if (parent == NO_PARENT) { break; }
+
+				const int step = (get_column(parent) != get_column(iter)) ? static_cast<int>(depth) : 1;
+				const int direction = (parent > iter) ? step : -step;
+
+				for (int between = static_cast<int>(iter) + direction; between != static_cast<int>(parent); between += direction) {
+					finished_path.push_back(&nodes[between]);
+				}
+			}
+
+			std::reverse(finished_path.begin(), finished_path.end());
+			return finished_path;
+		}
+
+		current.closed = true;
+
+		const int x = static_cast<int>(get_column(entry.index));
+		const int y = static_cast<int>(get_row(entry.index));
+
+		// Shortest paths are taken to move along x before y. A node reached along x may carry on or turn
+		// either way, one reached along y only turns where a wall stopped it taking that turn a step earlier
+		int arrival_x = 0;
+		int arrival_y = 0;
+		if (current.parent != NO_PARENT) {
+			arrival_x = x - static_cast<int>(get_column(current.parent));
+			arrival_y = y - static_cast<int>(get_row(current.parent));
+			arrival_x = (arrival_x > 0) - (arrival_x < 0);
+			arrival_y = (arrival_y > 0) - (arrival_y < 0);
+		}
+
+		UInt successors[4];
+		size_t successor_count = 0;
+
+		if (arrival_y == 0) {
+			if (arrival_x >= 0) { successors[successor_count++] = jump_horizontal(x, y, 1, end_index); }
+			if (arrival_x <= 0) { successors[successor_count++] = jump_horizontal(x, y, -1, end_index); }
+			successors[successor_count++] = jump_vertical(x, y, 1, end_index);
+			successors[successor_count++] = jump_vertical(x, y, -1, end_index);
+
+		} else {
+			successors[successor_count++] = jump_vertical(x, y, arrival_y, end_index);
+			if (is_open(x + 1, y) && !is_open(x + 1, y - arrival_y)) { successors[successor_count++] = jump_horizontal(x, y, 1, end_index); }
+			if (is_open(x - 1, y) && !is_open(x - 1, y - arrival_y)) { successors[successor_count++] = jump_horizontal(x, y, -1, end_index); }
+		}
+
+		for (size_t successor_iter = 0; successor_iter < successor_count; ++successor_iter) {
+			const UInt successor_index = successors[successor_iter];
+			if (successor_index == NO_PARENT) { continue; }
+
+			SearchNode& successor = get_search_node(context, successor_index);
+			if (successor.closed) { continue; }
+
+			// Jumps are straight, so their length is the distance between the two nodes
+			const int test_g = current.g + heuristic_estimate(entry.index, successor_index);
+			if (test_g >= successor.g) { continue; }
+
+			successor.parent = entry.index;
+			successor.g = test_g;
+			push_open(context, successor_index, test_g, heuristic_estimate(successor_index, end_index));
+		}
+	}
+
+	return std::vector<Node*>();
+}
+
+bool Map::has_line_of_sight(const Node* from_node, const Node* to_node) const {
+	const size_t from_index = get_index(from_node);
+	const size_t to_index = get_index(to_node);
+
+	int x = static_cast<int>(get_column(from_index));
+	int y = static_cast<int>(get_row(from_index));
+	const int delta_x = std::abs(static_cast<int>(get_column(to_index)) - x);
+	const int delta_y = std::abs(static_cast<int>(get_row(to_index)) - y);
+	const int step_x = (static_cast<int>(get_column(to_index)) > x) ? 1 : -1;
+	const int step_y = (static_cast<int>(get_row(to_index)) > y) ? 1 : -1;
+
+	if (!is_open(x, y)) { return false; }
+
+	// Every cell the line passes through is visited, the error tracks which border it crosses next
+	int error = delta_x - delta_y;
+	for (int remaining = delta_x + delta_y; remaining > 0; --remaining) {
+		if (error > 0) {
+			x += step_x;
+			error -= 2 * delta_y;
+
+		} else if (error < 0) {
+			y += step_y;
+			error += 2 * delta_x;
+
+		} else {
+			// Through a corner exactly, an enemy is not a point so neither side may be a wall
+			if (!is_open(x + step_x, y) || !is_open(x, y + step_y)) { return false; }
+
+			x += step_x;
+			y += step_y;
+			error += 2 * (delta_x - delta_y);
+			--remaining;
+		}
+
+		if (!is_open(x, y)) { return false; }
+	}
+
+	return true;
+}
+
+std::vector<Node*> Map::smooth_path(const std::vector<Node*>& path) const {
+	if (path.size() <= 2) { return path; }
+
+	std::vector<Node*> smoothed = { path.front() };
+	size_t anchor = 0;
+
+	for (size_t iter = 2; iter < path.size(); ++iter) {
+		if (has_line_of_sight(path.at(anchor), path.at(iter))) { continue; }
+
+		anchor = iter - 1;
+		smoothed.push_back(path.at(anchor));
+	}
+
+	smoothed.push_back(path.back());
+	return smoothed;
+}
+
+Node* Map::get_closest_node(const vec3& position) {
+	// Rounded to the nearest column and row, positions off the grid take the nearest edge node
+	const float column = std::round((position.x - static_cast<float>(x_origin)) / static_cast<float>(spacing));
+	const float row = std::round((position.z - static_cast<float>(z_origin)) / static_cast<float>(spacing));
+
+	const size_t x = static_cast<size_t>(std::min(std::max(column, 0.0f), static_cast<float>(width - 1)));
+	const size_t y = static_cast<size_t>(std::min(std::max(row, 0.0f), static_cast<float>(depth - 1)));
+
+	return get_node(x, y);
+}
+
+Node* Map::get_closest_open_node(const vec3& position) {
+	Node* closest = get_closest_node(position);
+	if (!closest->get_is_wall()) { return closest; }
+
+	const int centre_x = static_cast<int>(get_column(get_index(closest)));
+	const int centre_y = static_cast<int>(get_row(get_index(closest)));
+	const int max_radius = static_cast<int>(std::max(width, depth));
+	const float node_spacing = static_cast<float>(spacing);
+
+	// How far the position is from the centre node along either axis, half a node unless it is off the grid
+	const float offset = std::max(std::abs(static_cast<float>(closest->get_x()) - position.x), std::abs(static_cast<float>(closest->get_y()) - position.z));
+
+	Node* best = nullptr;
+	float best_distance = 0.0f;
+
+	// Rings of nodes further and further out, stopping once no node beyond the ring could be closer than the best found
+	for (int radius = 1; radius <= max_radius; ++radius) {
+		for (int x = centre_x - radius; x <= centre_x + radius; ++x) {
+			for (int y = centre_y - radius; y <= centre_y + radius; ++y) {
+				// Only the ring itself, the inside was searched already
+				if ((std::abs(x - centre_x) != radius) && (std::abs(y - centre_y) != radius)) { continue; }
+				if (!is_open(x, y)) { continue; }
+
+				Node* node = get_node(static_cast<size_t>(x), static_cast<size_t>(y));
+				const float offset_x = static_cast<float>(node->get_x()) - position.x;
+				const float offset_z = static_cast<float>(node->get_y()) - position.z;
+				const float node_distance = (offset_x * offset_x) + (offset_z * offset_z);
+
+				if (!best || (node_distance < best_distance)) {
+					best = node;
+					best_distance = node_distance;
+				}
+			}
+		}
+
+		const float next_ring_distance = (static_cast<float>(radius + 1) * node_spacing) - offset;
+		if (best && (next_ring_distance > 0.0f) && ((next_ring_distance * next_ring_distance) >= best_distance)) { break; }
+	}
+
+	return best;
+}
+
+void Map::update_flow_field(Node* goal_node) {
+	const size_t goal_index = get_index(goal_node);
+	if (goal_index == flow_goal) { return; }
+
+	flow_goal = static_cast<UInt>(goal_index);
+	std::fill(flow_next.begin(), flow_next.end(), NO_PARENT);
+	if (goal_node->get_is_wall()) { return; }
+
+	begin_search(search_context);
+
+	// Every move costs the same, so a breadth first search settles nodes in the order Dijkstra's would
+	flow_frontier.clear();
+	flow_frontier.push_back(flow_goal);
+	get_search_node(search_context, goal_index).closed = true;
+
+	for (size_t frontier_iter = 0; frontier_iter < flow_frontier.size(); ++frontier_iter) {
+		const UInt current_index = flow_frontier[frontier_iter];
+
+		size_t neighbours[4];
+		const size_t neighbour_count = get_neighbours(current_index, neighbours);
+
+		for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+			const size_t neighbour_index = neighbours[neighbour_iter];
+			if (nodes[neighbour_index].get_is_wall()) { continue; }
+
+			SearchNode& neighbour = get_search_node(search_context, neighbour_index);
+			if (neighbour.closed) { continue; }
+
+			// Reached from the goal's side, so stepping back the way it was reached leads to the goal
+			neighbour.closed = true;
+			flow_next[neighbour_index] = current_index;
+			flow_frontier.push_back(static_cast<UInt>(neighbour_index));
+		}
+	}
+}
+
+Node* Map::get_flow_node(Node* current) {
+	const UInt next_index = flow_next[get_index(current)];
+	return (next_index == NO_PARENT) ? nullptr : &nodes[next_index];
+}
+
+void Map::set_wall(Node* node, const bool is_wall) {
+	if (node->get_is_wall() == is_wall) { return; }
+
+	node->set_wall(is_wall);
+	wall_changes.push_back(static_cast<UInt>(get_index(node)));
+
+	// The field is rebuilt the next time it is updated, even for the same goal
+	flow_goal = NO_PARENT;
+	components_current = false;
+}
+
+void Map::update_components() {
+	components.assign(nodes.size(), MapFile::NO_COMPONENT);
+	UInt component = 0;
+
+	// The flow field's frontier is free to borrow, it is only used while building a field
+	for (size_t iter = 0; iter < nodes.size(); ++iter) {
+		if (nodes[iter].get_is_wall() || (components[iter] != MapFile::NO_COMPONENT)) { continue; }
+
+		components[iter] = component;
+		flow_frontier.assign(1, static_cast<UInt>(iter));
+
+		for (size_t frontier_iter = 0; frontier_iter < flow_frontier.size(); ++frontier_iter) {
+			size_t neighbours[4];
+			const size_t neighbour_count = get_neighbours(flow_frontier[frontier_iter], neighbours);
+
+			for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+				const size_t neighbour_index = neighbours[neighbour_iter];
+				if (nodes[neighbour_index].get_is_wall() || (components[neighbour_index] != MapFile::NO_COMPONENT)) { continue; }
+
+				components[neighbour_index] = component;
+				flow_frontier.push_back(static_cast<UInt>(neighbour_index));
+			}
+		}
+
+		++component;
+	}
+
+	components_current = true;
+}
+
+void Map::begin_search(SearchContext& context) const {
+	context.open_set.clear();
+
+	// Contexts are sized on their first search, so one made before the map is ready still works
+	if (context.search_nodes.size() != nodes.size()) {
+		context.search_nodes.assign(nodes.size(), { 0, NO_PARENT, 0, false });
+		context.search_number = 0;
+	}
+
+	// Stale numbers could match again once the counter wraps around, so that one time they are cleared
+	if (++context.search_number == 0) {
+		for (size_t iter = 0; iter < context.search_nodes.size(); ++iter) { context.search_nodes[iter].search_number = 0; }
+		context.search_number = 1;
+	}
+}
+
+Map::SearchNode& Map::get_search_node(SearchContext& context, const size_t& index) {
+	SearchNode& search_node = context.search_nodes[index];
+
+	if (search_node.search_number != context.search_number) {
+		search_node = { INT_MAX, NO_PARENT, context.search_number, false };
+	}
+
+	return search_node;
+}
+
+void Map::push_open(SearchContext& context, const size_t& index, const int& g, const int& h) {
+	context.open_set.push_back({ g + h, h, static_cast<UInt>(index) });
+	std::push_heap(context.open_set.begin(), context.open_set.end(), is_worse_entry);
+}
+
+size_t Map::get_neighbours(const size_t& index, size_t (&neighbours)[4]) const {
+	const size_t x = index / depth;
+	const size_t y = index % depth;
+	size_t neighbour_count = 0;
+
+	if (x > 0)				{ neighbours[neighbour_count++] = get_index(x - 1, y); }
+	if (x < (width - 1))	{ neighbours[neighbour_count++] = get_index(x + 1, y); }
+	if (y > 0)				{ neighbours[neighbour_count++] = get_index(x, y - 1); }
+	if (y < (depth - 1))	{ neighbours[neighbour_count++] = get_index(x, y + 1); }
+
+	return neighbour_count;
+}
+
+int Map::heuristic_estimate(const size_t& start_index, const size_t& end_index) const {
+	// Steps are along the grid's axes only, so the Manhattan distance in steps never overestimates
+	const int delta_x = static_cast<int>(start_index / depth) - static_cast<int>(end_index / depth);
+	const int delta_y = static_cast<int>(start_index % depth) - static_cast<int>(end_index % depth);
+
+	return std::abs(delta_x) + std::abs(delta_y);
+}
+
+int Map::movement_cost(const size_t& start_index, const size_t& end_index) const {
     // This function is defined only so that if in
     // the future I ever want to add diagonal movement it is easier
     return 1;
 }
 
-unsigned int Map::heuristic_estimate(Node* start_node, Node* end_node){
-    int delta_x = end_node->get_x() - start_node->get_x();
-	int delta_y = end_node->get_y() - start_node->get_y();
-    
-    return static_cast<int>(std::sqrt(delta_x * delta_x + delta_y * delta_y));
-}
+std::vector<Node*> Map::reconstruct_path(const SearchContext& context, const size_t& end_index){
+	std::vector<Node*> finished_path;
+
+	for (UInt iter = static_cast<UInt>(end_index); iter != NO_PARENT; iter = context.search_nodes[iter].parent) {
+		finished_path.push_back(&nodes[iter]);
+	}
 
-std::vector<Node*> Map::reconstruct_path(Node* current){
-    std::vector<Node*> finished_path = { current };
-    
-    Node* iter = current;
-    
-    while (iter->get_parent()){
-        iter = iter->get_parent();
-        finished_path.push_back(iter);
-    }
-    
     std::reverse(finished_path.begin(), finished_path.end());
-    
+
     return finished_path;
 }
 
-std::vector<Node*> Map::get_node_neighbours(Node* current){
-    std::pair<size_t, size_t> node_coords = get_location_of_node_in_map(current);
-    
-    std::vector<Node*> node_neighbours;
-    
-    size_t x = node_coords.first;
-    size_t y = node_coords.second;
-    
-    // Checking node boundaries
-    if (x > 0){
-        Node* left_node = node_map.at(x - 1).at(y);
-        node_neighbours.push_back(left_node);
-    }
-    
-    if (x < (node_map.size() -1)){
-        Node* right_node = node_map.at(x + 1).at(y);
-        node_neighbours.push_back(right_node);
-    }
-
-    if (y > 0){
-        Node* up_node = node_map.at(x).at(y - 1);
-        node_neighbours.push_back(up_node);
-    }
-    
-    if (y < (node_map.at(x).size() - 1)){
-        Node* down_node = node_map.at(x).at(y + 1);
-        node_neighbours.push_back(down_node);
-    }
-    
-    return node_neighbours;
-}
-
-std::pair<size_t, size_t> Map::get_location_of_node_in_map(Node* current){
-    bool found_current = false;
-    std::pair<size_t, size_t> coordinates;
-    
-    for (size_t x = 0; x < node_map.size(); ++x){
-        std::vector<Node*> column = node_map.at(x);
-        
-        for (size_t y = 0; y < column.size(); ++y){
-            Node* node = column.at(y);
-            if (node == current){
-                found_current = true;
-                coordinates = { x, y };
-                break;
-            }
-        }
-        
-        if (found_current) { break; }
-    }
-    
-    if (!found_current){
-        throw std::runtime_error("Could not find current node in map");
-    }
-    
-    return coordinates;
+bool Map::is_open(const int& x, const int& y) const {
+	if ((x < 0) || (y < 0) || (x >= static_cast<int>(width)) || (y >= static_cast<int>(depth))) { return false; }
+	return !nodes[get_index(static_cast<size_t>(x), static_cast<size_t>(y))].get_is_wall();
 }
 
-void Map::reset() {
-	for (size_t i = 0; i < node_map.size(); ++i) {
-		for (size_t j = 0; j < node_map.at(i).size(); ++j) {
-			node_map.at(i).at(j)->reset();
-		}
+UInt Map::jump_horizontal(int x, const int& y, const int& delta_x, const size_t& end_index) const {
+	for (;;) {
+		x += delta_x;
+		if (!is_open(x, y)) { return NO_PARENT; }
+
+		const UInt index = static_cast<UInt>(get_index(static_cast<size_t>(x), static_cast<size_t>(y)));
+		if (index == end_index) { return index; }
+
+		// Any node reached along x may turn, it only needs to be stopped at if turning leads somewhere
+		if ((jump_vertical(x, y, 1, end_index) != NO_PARENT) || (jump_vertical(x, y, -1, end_index) != NO_PARENT)) { return index; }
 	}
 }
 
-std::vector<Node*> Map::get_all_nodes() {
-    std::vector<Node*> return_list;
-    
-    for (size_t x = 0; x < node_map.size(); ++x){
-        for (size_t y = 0; y < node_map.at(x).size(); ++y){
-            return_list.push_back(node_map.at(x).at(y));
-        }
-    }
-    
-    return return_list;
+UInt Map::jump_vertical(const int& x, int y, const int& delta_y, const size_t& end_index) const {
+	for (;;) {
+		y += delta_y;
+		if (!is_open(x, y)) { return NO_PARENT; }
+
+		const UInt index = static_cast<UInt>(get_index(static_cast<size_t>(x), static_cast<size_t>(y)));
+		if (index == end_index) { return index; }
+
+		// A side that opens up just past a wall could not have been reached by moving along x first
+		if (is_open(x + 1, y) && !is_open(x + 1, y - delta_y)) { return index; }
+		if (is_open(x - 1, y) && !is_open(x - 1, y - delta_y)) { return index; }
+	}
 }
 
-Node* Map::get_closest_node(const vec3& position) {
-    vec2 c = { position.x, position.z };
-    Node* closest = nullptr;
-    
-    for (size_t i = 0; i < get_node_map_size(); ++i){
-        for (size_t j = 0; j < get_node_column_size(i); ++j){
-            Node* current = node_map.at(i).at(j);
-            if (!closest) { closest = current; continue; }
-            vec2 node_pos = { static_cast<float>(current->get_x()), static_cast<float>(current->get_y()) };
-            
-            auto dist = distance(c, node_pos);
-            if (dist < distance(c, { static_cast<float>(closest->get_x()), static_cast<float>(closest->get_y()) })){
-                closest = current;
-            }
-        }
-    }
-    
-    return closest;
+bool Map::is_worse_entry(const OpenEntry& left, const OpenEntry& right) {
+	// The heap keeps its greatest element first, so the lowest f (nearest the goal on ties) must compare greatest
+	if (left.f != right.f) { return left.f > right.f; }
+	return left.h > right.h;
 }
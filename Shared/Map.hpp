@@ -1,46 +1,176 @@
 #pragma once
 
 #include "Node.hpp"
+#include "MapFile.hpp"
 
-class NodeQueue : public std::vector<Node*> {
-public:
-	NodeQueue(Node* node) : std::vector<Node*>(std::vector<Node*> { node }) {}
 
-	void sort_insert(Node* node) {
-		std::vector<Node*>::iterator iter = std::upper_bound(this->begin(), this->end(), node, NodeComparison);
-		this->insert(iter, node);
-	}
+struct GridBounds {
+	// Inclusive columns (x) and rows (y) of the grid a search may use
+	size_t min_x;
+	size_t min_y;
+	size_t max_x;
+	size_t max_y;
 
-	void manual_sort() {
-		std::sort(this->begin(), this->end(), NodeComparison);
-	}
+	inline bool contains(const size_t& x, const size_t& y) const { return (x >= min_x) && (x <= max_x) && (y >= min_y) && (y <= max_y); }
 };
 
 
 class Map {
+	/*
+	A navigation grid of evenly spaced nodes, searched with A*
+
+	Nodes are kept in one array indexed by their column and row, so neighbours and the node
+	closest to a position are found with arithmetic rather than by searching. The open set is a
+	binary heap: a node whose cost improves is pushed again and its older entry is skipped when
+	popped. Search state carries the number of the search that last wrote it, anything older
+	counts as unvisited, so nothing is cleared between searches
+
+	For many agents heading to the same place the map can instead hold a flow field: one search
+	outward from the goal gives every node the neighbour to step to next, so following it costs
+	the same however many agents there are
+
+	Since every step costs the same, jump_point_pathfind() finds paths as short as A* while
+	only stopping at the nodes where a shortest path might have to turn, skipping the runs of
+	open nodes between them that A* would otherwise push one by one
+
+	Search state lives in a SearchContext rather than the nodes. The map keeps one of its own,
+	and searches given another only touch that one, so each thread with its own context can
+	search the same map at once, as long as no walls change meanwhile
+
+	Open nodes are labelled by connected component, so a search for a goal that no path leads to
+	is refused straight away rather than after visiting everything the start can reach
+
+	Walls changed once searching has begun must go through set_wall(), which records them so
+	that searches kept between frames (IncrementalPath) can repair themselves
+
+	Node pointers stay valid for the life of the map
+	*/
+
 public:
-    Map() {}
-    Map(const std::vector<std::vector<Node*>>& node_map) : node_map(node_map) {}
-    Map(const Map& other) : node_map(other.node_map) {}
-    void operator=(const Map& other) { node_map = other.node_map; }
-    
-    virtual ~Map();
-    
-    std::vector<Node*> a_star_pathfind(Node* start_node, Node* end_node);
-    
-    unsigned int heuristic_estimate(Node* start_node, Node* end_node);
-    std::vector<Node*> reconstruct_path(Node* current);
-    std::vector<Node*> get_node_neighbours(Node* current);
-    std::vector<Node*> get_all_nodes();
-    std::pair<size_t, size_t> get_location_of_node_in_map(Node* current);
-	void reset();
-    int movement_cost(Node* start, Node* end);
+	struct SearchContext;
+
+	// Bounds are inclusive and in world units, nodes are placed every 'spacing' units from the lower bounds
+	Map(const int& x_lower_bound, const int& x_upper_bound, const int& z_lower_bound, const int& z_upper_bound, const int& spacing);
+
+	// Walls and, if the file has them, components come from the file
+	Map(const MapFile& file);
+
+	Map(const Map& other) = delete;
+	void operator=(const Map& other) = delete;
+
+	// Nodes outside the bounds are never stepped on, the whole grid is searched without them
+    std::vector<Node*> a_star_pathfind(Node* start_node, Node* end_node, const GridBounds* bounds = nullptr);
+	std::vector<Node*> a_star_pathfind(SearchContext& context, Node* start_node, Node* end_node, const GridBounds* bounds = nullptr);
+
+	// The same length of path as a_star_pathfind(), found with Jump Point Search for 4-connected grids
+	std::vector<Node*> jump_point_pathfind(Node* start_node, Node* end_node);
+	std::vector<Node*> jump_point_pathfind(SearchContext& context, Node* start_node, Node* end_node);
+
+	// Whether a straight line between the nodes only crosses open nodes' cells, both sides counting where it meets a corner
+	bool has_line_of_sight(const Node* from_node, const Node* to_node) const;
+
+	// Drops every node of the path that can be skipped by walking straight from the last one kept, ends always kept
+	std::vector<Node*> smooth_path(const std::vector<Node*>& path) const;
+
     Node* get_closest_node(const vec3& position);
-    
-    inline Node* get_node(size_t x, size_t y){ return node_map.at(x).at(y); }
-    inline size_t get_node_map_size() { return node_map.size(); }
-    inline size_t get_node_column_size(const size_t x) { return node_map.at(x).size(); }
-    
+
+	// As get_closest_node(), but never a wall, for positions that have strayed into a wall's cell
+	// nullptr only when every node is a wall
+	Node* get_closest_open_node(const vec3& position);
+
+	// Recomputed only when the goal is a different node to last time
+	void update_flow_field(Node* goal_node);
+
+	// The next node towards the flow field's goal, nullptr at the goal, when it cannot be reached or without a field
+	Node* get_flow_node(Node* current);
+
+	void set_wall(Node* node, const bool is_wall);
+	inline size_t get_wall_change_count() const { return wall_changes.size(); }
+	inline size_t get_wall_change(const size_t& change) const { return wall_changes.at(change); }
+
+	// Needed after walls are changed through the nodes themselves, set_wall() keeps track on its own
+	void update_components();
+	inline const std::vector<UInt>& get_components() const { return components; }
+
+	// False only when the nodes are known to be in different components, so no path joins them
+	inline bool may_reach(const size_t& start_index, const size_t& end_index) const { return !components_current || (components[start_index] == components[end_index]); }
+
+    inline Node* get_node(size_t x, size_t y) { return &nodes.at(get_index(x, y)); }
+    inline size_t get_node_map_size() const { return width; }
+    inline size_t get_node_column_size(const size_t x) const { return depth; }
+
+	// Nodes by their index in the array, for searches that keep per node state of their own
+	inline size_t get_node_count() const { return nodes.size(); }
+	inline Node* get_node_at(const size_t& index) { return &nodes[index]; }
+	inline size_t get_index(const Node* node) const { return static_cast<size_t>(node - nodes.data()); }
+	inline size_t get_index(const size_t& x, const size_t& y) const { return (x * depth) + y; }
+	inline size_t get_column(const size_t& index) const { return index / depth; }
+	inline size_t get_row(const size_t& index) const { return index % depth; }
+
+	// Fills in the indices of the up to four nodes beside this one and returns how many there are
+	size_t get_neighbours(const size_t& index, size_t (&neighbours)[4]) const;
+
+	int heuristic_estimate(const size_t& start_index, const size_t& end_index) const;
+	int movement_cost(const size_t& start_index, const size_t& end_index) const;
+
+private:
+	static const UInt NO_PARENT = UINT_MAX;
+
+	struct SearchNode {
+		int g;
+		UInt parent;
+		UInt search_number;		// The search that last wrote this, older values are stale
+		bool closed;
+	};
+
+	struct OpenEntry {
+		int f;
+		int h;
+		UInt index;
+	};
+
+public:
+	struct SearchContext {
+		// Scratch state for one search at a time, sized by the map on its first search
+	private:
+		friend class Map;
+
+		std::vector<SearchNode> search_nodes;
+		std::vector<OpenEntry> open_set;
+		UInt search_number = 0;
+	};
+
 private:
-    std::vector<std::vector<Node*>> node_map;
+	size_t width;	// Columns along x
+	size_t depth;	// Rows along z
+	int x_origin;
+	int z_origin;
+	int spacing;
+
+	std::vector<Node> nodes;	// Column major, matching get_node(x, y)
+	SearchContext search_context;	// For searches not given a context, and the flow field
+
+	std::vector<UInt> flow_next;	// Per node, NO_PARENT where there is no step to take
+	std::vector<UInt> flow_frontier;
+	UInt flow_goal = NO_PARENT;
+
+	std::vector<UInt> wall_changes;		// Indices of nodes changed by set_wall(), oldest first
+
+	std::vector<UInt> components;		// Per node, MapFile::NO_COMPONENT for walls
+	bool components_current = false;	// Unknown until updated or loaded, and again after set_wall()
+
+	void begin_search(SearchContext& context) const;
+	static SearchNode& get_search_node(SearchContext& context, const size_t& index);
+	static void push_open(SearchContext& context, const size_t& index, const int& g, const int& h);
+
+	std::vector<Node*> reconstruct_path(const SearchContext& context, const size_t& end_index);
+
+	// Off the grid counts as a wall
+	bool is_open(const int& x, const int& y) const;
+
+	// Steps from the node until reaching one a shortest path could turn at, NO_PARENT if a wall or the edge comes first
+	UInt jump_horizontal(int x, const int& y, const int& delta_x, const size_t& end_index) const;
+	UInt jump_vertical(const int& x, int y, const int& delta_y, const size_t& end_index) const;
+
+	static bool is_worse_entry(const OpenEntry& left, const OpenEntry& right);
 };
@@ -0,0 +1,158 @@
+#include "MapFile.hpp"
+
+const UInt MapFile::HAS_COMPONENTS;
+const UInt MapFile::NO_COMPONENT;
+const UInt MapFile::VERSION;
+
+
+namespace {
+	const char MAGIC[4] = { 'S', 'V', 'M', 'P' };
+
+	class ByteReader {
+	public:
+		ByteReader(const std::vector<char>& bytes) : bytes(bytes) {}
+
+		UInt read_uint() {
+			require(4);
+
+			UInt value = 0;
+			for (size_t iter = 0; iter < 4; ++iter) { value |= static_cast<UInt>(static_cast<unsigned char>(bytes[position + iter])) << (8 * iter); }
+
+			position += 4;
+			return value;
+		}
+
+		inline int read_int() { return static_cast<int>(read_uint()); }
+
+		float read_float() {
+			const UInt bits = read_uint();
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+
+			return value;
+		}
+
+		const char* read_bytes(const size_t& count) {
+			require(count);
+
+			const char* start = &bytes[position];
+			position += count;
+			return start;
+		}
+
+	private:
+		const std::vector<char>& bytes;
+		size_t position = 0;
+
+		void require(const size_t& count) const {
+			if ((position + count) > bytes.size()) { throw std::runtime_error("Map file ends before all of its data"); }
+		}
+	};
+
+	void write_uint(std::vector<char>& bytes, const UInt& value) {
+		for (size_t iter = 0; iter < 4; ++iter) { bytes.push_back(static_cast<char>((value >> (8 * iter)) & 0xFF)); }
+	}
+
+	void write_float(std::vector<char>& bytes, const float& value) {
+		UInt bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		write_uint(bytes, bits);
+	}
+}
+
+MapFile::MapFile(const std::string& full_path) {
+	std::ifstream file(full_path, std::ios::binary | std::ios::ate);
+	if (!file) { throw std::runtime_error("Could not open map file " + full_path); }
+
+	std::vector<char> bytes(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!bytes.empty() && !file.read(&bytes[0], static_cast<std::streamsize>(bytes.size()))) { throw std::runtime_error("Could not read map file " + full_path); }
+
+	ByteReader reader(bytes);
+	if (std::memcmp(reader.read_bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) { throw std::runtime_error(full_path + " is not a map file"); }
+	if (reader.read_uint() != VERSION) { throw std::runtime_error(full_path + " is from an unsupported version"); }
+
+	x_lower_bound = reader.read_int();
+	z_lower_bound = reader.read_int();
+	spacing = reader.read_int();
+	width = reader.read_uint();
+	depth = reader.read_uint();
+
+	const UInt flags = reader.read_uint();
+	const UInt spawn_zone_count = reader.read_uint();
+
+	if ((spacing <= 0) || (width == 0) || (depth == 0)) { throw std::runtime_error(full_path + " has an empty grid"); }
+
+	for (UInt iter = 0; iter < spawn_zone_count; ++iter) {
+		SpawnZone zone;
+		zone.min_x = reader.read_float();
+		zone.min_z = reader.read_float();
+		zone.max_x = reader.read_float();
+		zone.max_z = reader.read_float();
+		spawn_zones.push_back(zone);
+	}
+
+	const size_t node_count = static_cast<size_t>(width) * depth;
+	const char* wall_bits = reader.read_bytes((node_count + 7) / 8);
+
+	walls.resize(node_count);
+	for (size_t iter = 0; iter < node_count; ++iter) {
+		walls[iter] = ((static_cast<unsigned char>(wall_bits[iter / 8]) >> (iter % 8)) & 1) != 0;
+	}
+
+	if (flags & HAS_COMPONENTS) {
+		components.resize(node_count);
+		for (size_t iter = 0; iter < node_count; ++iter) { components[iter] = reader.read_uint(); }
+	}
+}
+
+MapFile::MapFile(const int& x_lower_bound, const int& z_lower_bound, const UInt& width, const UInt& depth, const int& spacing) :
+x_lower_bound(x_lower_bound),
+z_lower_bound(z_lower_bound),
+spacing(spacing),
+width(width),
+depth(depth),
+walls(static_cast<size_t>(width) * depth, false) {}
+
+void MapFile::save(const std::string& full_path) const {
+	std::vector<char> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+
+	write_uint(bytes, VERSION);
+	write_uint(bytes, static_cast<UInt>(x_lower_bound));
+	write_uint(bytes, static_cast<UInt>(z_lower_bound));
+	write_uint(bytes, static_cast<UInt>(spacing));
+	write_uint(bytes, width);
+	write_uint(bytes, depth);
+	write_uint(bytes, has_components() ? HAS_COMPONENTS : 0);
+	write_uint(bytes, static_cast<UInt>(spawn_zones.size()));
+
+	for (size_t iter = 0; iter < spawn_zones.size(); ++iter) {
+		write_float(bytes, spawn_zones[iter].min_x);
+		write_float(bytes, spawn_zones[iter].min_z);
+		write_float(bytes, spawn_zones[iter].max_x);
+		write_float(bytes, spawn_zones[iter].max_z);
+	}
+
+	std::vector<char> wall_bits((walls.size() + 7) / 8, 0);
+	for (size_t iter = 0; iter < walls.size(); ++iter) {
+		if (walls[iter]) { wall_bits[iter / 8] = static_cast<char>(wall_bits[iter / 8] | (1 << (iter % 8))); }
+	}
+
+	bytes.insert(bytes.end(), wall_bits.begin(), wall_bits.end());
+	for (size_t iter = 0; iter < components.size(); ++iter) { write_uint(bytes, components[iter]); }
+
+	std::ofstream file(full_path, std::ios::binary | std::ios::trunc);
+	if (!file || !file.write(&bytes[0], static_cast<std::streamsize>(bytes.size()))) { throw std::runtime_error("Could not write map file " + full_path); }
+}
+
+void MapFile::set_components(const std::vector<UInt>& new_components) {
+	if (!new_components.empty() && (new_components.size() != walls.size())) { throw std::runtime_error("Map file components must have one per node"); }
+	components = new_components;
+}
+
+void MapFile::set_wall(const size_t& x, const size_t& y, const bool is_wall) {
+	if (walls.at(get_index(x, y)) == is_wall) { return; }
+
+	walls.at(get_index(x, y)) = is_wall;
+	components.clear();
+}
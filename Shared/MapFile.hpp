@@ -0,0 +1,75 @@
+#pragma once
+
+#include "EngineHeader.hpp"
+
+
+struct SpawnZone {
+	// Inclusive world space rectangle on the ground
+	float min_x;
+	float min_z;
+	float max_x;
+	float max_z;
+};
+
+
+class MapFile {
+	/*
+	A navigation grid's layout, saved so that maps can be made without changing code
+
+	Layout, every number a little endian 32 bit value:
+		"SVMP", version
+		x lower bound, z lower bound, spacing (signed, world units)
+		width (columns along x), depth (rows along z), flags, spawn zone count
+		spawn zones, four floats each (min x, min z, max x, max z)
+		walls, one bit per node in column major order, lowest bit first, padded to a whole byte
+		connected components, one per node, only when flagged (HAS_COMPONENTS)
+
+	The whole file is read at once and then unpacked from memory, Tools/MakeOriginalMap.cpp writes the game's map
+	*/
+
+public:
+	static const UInt HAS_COMPONENTS = 1;
+	static const UInt NO_COMPONENT = UINT_MAX;	// The component of every wall
+
+	// Throws if the file is missing, truncated or not a map
+	MapFile(const std::string& full_path);
+
+	// An open grid with no spawn zones, for making maps in code
+	MapFile(const int& x_lower_bound, const int& z_lower_bound, const UInt& width, const UInt& depth, const int& spacing);
+
+	void save(const std::string& full_path) const;
+
+	inline int get_x_lower_bound() const { return x_lower_bound; }
+	inline int get_z_lower_bound() const { return z_lower_bound; }
+	inline int get_x_upper_bound() const { return x_lower_bound + (static_cast<int>(width) - 1) * spacing; }
+	inline int get_z_upper_bound() const { return z_lower_bound + (static_cast<int>(depth) - 1) * spacing; }
+	inline int get_spacing() const { return spacing; }
+	inline UInt get_width() const { return width; }
+	inline UInt get_depth() const { return depth; }
+
+	inline bool is_wall(const size_t& x, const size_t& y) const { return walls.at(get_index(x, y)); }
+	void set_wall(const size_t& x, const size_t& y, const bool is_wall);
+
+	inline const std::vector<SpawnZone>& get_spawn_zones() const { return spawn_zones; }
+	inline void add_spawn_zone(const SpawnZone& zone) { spawn_zones.push_back(zone); }
+
+	// One per node (Map::get_components()), labelling open nodes by which others they can reach
+	void set_components(const std::vector<UInt>& new_components);
+	inline bool has_components() const { return !components.empty(); }
+	inline const std::vector<UInt>& get_components() const { return components; }
+
+private:
+	static const UInt VERSION = 1;
+
+	int x_lower_bound;
+	int z_lower_bound;
+	int spacing;
+	UInt width;
+	UInt depth;
+
+	std::vector<bool> walls;		// Column major, as the map's nodes are
+	std::vector<SpawnZone> spawn_zones;
+	std::vector<UInt> components;	// Empty unless set or loaded, cleared when a wall changes
+
+	inline size_t get_index(const size_t& x, const size_t& y) const { return (x * depth) + y; }
+};
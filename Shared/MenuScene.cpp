@@ -26,8 +26,8 @@ exit(GameConstants::MECHA(), "Exit") {
 	setup_framebuffer();
 
     Program& shape_program = ResourceHandler::get_instance().get_program(Shape::GENERIC_ID());
-	shape_program.set_uniform<float>("far_plane", GameConstants::far_plane);
-	shape_program.set_uniform<bool>("use_light_colour", true);
+	shape_program.set_persistent_uniform<float>("far_plane", GameConstants::far_plane);
+	if (light_program) { light_program->set_feature(LightMapFeatures::LIGHT_COLOUR, true); }
 }
 
 void MenuScene::bind_callbacks(){
@@ -60,12 +60,12 @@ void MenuScene::pre_render(){
 	handle_held_keys();
 
 	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Cube::GENERIC_ID()));
-	light_program->set_uniform<bool>("use_shadows", use_shadows);
+	light_program->set_feature(LightMapFeatures::SHADOWS, use_shadows);
 
 	if (using_shadows()) {
 		glActiveTexture(GL_TEXTURE31);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
-		ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_uniform<int>("depth_map", 31);
+		ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_persistent_uniform<int>("depth_map", 31);
         
         render_framebuffer();
 	}
@@ -97,17 +97,13 @@ void MenuScene::render(){
 	const mat4 vp = perspective(GameConstants::FOV, aspect_ratio, GameConstants::near_plane, GameConstants::far_plane) * view_matrix;
     
     ResourceHandler& instance = ResourceHandler::get_instance();
-	instance.get_program(Shape::GENERIC_ID()).set_uniform<mat4>("VP", vp);
-	instance.get_program(Shape::GENERIC_ID()).set_uniform<vec3>("view_position", camera->get_position());
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<mat4>("VP", vp);
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<vec3>("view_position", camera->get_position());
 	instance.get_program("3DText").set_uniform<mat4>("VP", vp);
 
 	for (size_t iter = 0; iter < renderables.size(); ++iter) { renderables.at(iter)->render(); }
 
-	dynamic_cast<Renderable*>(&left_column)->render();
-	dynamic_cast<Renderable*>(&right_column)->render();
-	dynamic_cast<Renderable*>(&top_column)->render();
-	dynamic_cast<Renderable*>(&bottom_column)->render();
-	dynamic_cast<Renderable*>(&background)->render();
+	static_geometry.render(Shape::GENERIC_ID());
 
 	title.render("3DText");
 	play.render("3DText");
@@ -194,6 +190,14 @@ void MenuScene::init(){
 	exit.set_position(vec3(0.0f, -13.0f, -35.0f));
     exit.set_horisontal_align();
 	exit.set_colour(Colours::BLACK);
+
+	// Merged only once every cuboid has its final position and texture
+	static_geometry.add(left_column);
+	static_geometry.add(right_column);
+	static_geometry.add(top_column);
+	static_geometry.add(bottom_column);
+	static_geometry.add(background);
+	static_geometry.build();
 }
 
 void MenuScene::change_choice(bool value) {
@@ -305,11 +309,7 @@ void MenuScene::render_framebuffer() {
 		renderable->render("Shadow");
 	}
 
-	left_column.render("Shadow");
-	right_column.render("Shadow");
-	top_column.render("Shadow");
-	bottom_column.render("Shadow");
-	background.render("Shadow");
+	static_geometry.render("Shadow");
 
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "BaseScene.hpp"
 #include "Cuboid.hpp"
+#include "StaticBatch.hpp"
 #include "Text.hpp"
 #include "WindowWrapper.hpp"
 
@@ -74,6 +75,9 @@ private:
     Cuboid top_column;
     Cuboid bottom_column;
     Cuboid background;
+
+    // The five cuboids above merged, they never move after init
+    StaticBatch static_geometry;
     
     Text title;
     Text play;
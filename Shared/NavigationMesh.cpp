@@ -0,0 +1,593 @@
+#include "NavigationMesh.hpp"
+#include <algorithm>
+#include <map>
+#include <limits>
+
+const UInt NavigationMesh::NO_POLYGON;
+
+
+namespace {
+	// Keeps the part of a polygon on one side of an axis aligned plane in x (axis 0) or z (axis 2)
+	void clip_polygon(const std::vector<vec3>& input, const int axis, const float bound, const bool keep_greater, std::vector<vec3>& output) {
+		output.clear();
+
+		for (size_t iter = 0; iter < input.size(); ++iter) {
+			const vec3& current = input[iter];
+			const vec3& next = input[(iter + 1) % input.size()];
+
+			const float current_distance = ((axis == 0) ? current.x : current.z) - bound;
+			const float next_distance = ((axis == 0) ? next.x : next.z) - bound;
+			const bool current_inside = keep_greater ? (current_distance >= 0.0f) : (current_distance <= 0.0f);
+			const bool next_inside = keep_greater ? (next_distance >= 0.0f) : (next_distance <= 0.0f);
+
+			if (current_inside) { output.push_back(current); }
+			if (current_inside != next_inside) {
+				const float t = current_distance / (current_distance - next_distance);
+				output.push_back(current + ((next - current) * t));
+			}
+		}
+	}
+}
+
+NavigationMesh::NavigationMesh(const NavigationMeshSettings& settings) : settings(settings) {}
+
+void NavigationMesh::build(Model& model) {
+	const mat4 model_matrix = model.get_model_matrix();
+	std::vector<vec3> triangles;
+
+	for (size_t mesh_iter = 0; mesh_iter < model.meshes.size(); ++mesh_iter) {
+		const Mesh& mesh = model.meshes.at(mesh_iter);
+		const std::vector<MeshVertex>& vertices = mesh.get_vertices();
+		const std::vector<UInt>& indices = mesh.get_indices();
+
+		for (size_t iter = 0; (iter + 2) < indices.size(); iter += 3) {
+			for (size_t corner = 0; corner < 3; ++corner) {
+				vec4 position(vertices.at(indices[iter + corner]).position, 1.0f);
+				triangles.push_back(to_vec3(model_matrix * position));
+			}
+		}
+	}
+
+	build(triangles);
+}
+
+void NavigationMesh::build(const std::vector<vec3>& triangles) {
+	polygons.clear();
+	cell_polygons.clear();
+	search_polygons.clear();
+	width = 0;
+	depth = 0;
+
+	if (triangles.size() < 3) { return; }
+
+	float max_x = triangles.front().x;
+	float max_z = triangles.front().z;
+	origin_x = triangles.front().x;
+	origin_z = triangles.front().z;
+
+	for (size_t iter = 1; iter < triangles.size(); ++iter) {
+		origin_x = std::min(origin_x, triangles[iter].x);
+		origin_z = std::min(origin_z, triangles[iter].z);
+		max_x = std::max(max_x, triangles[iter].x);
+		max_z = std::max(max_z, triangles[iter].z);
+	}
+
+	width = std::max(static_cast<size_t>(std::ceil((max_x - origin_x) / settings.cell_size)), static_cast<size_t>(1));
+	depth = std::max(static_cast<size_t>(std::ceil((max_z - origin_z) / settings.cell_size)), static_cast<size_t>(1));
+
+	std::vector<std::vector<Span>> columns(width * depth);
+	for (size_t iter = 0; (iter + 2) < triangles.size(); iter += 3) {
+		rasterise_triangle(triangles[iter], triangles[iter + 1], triangles[iter + 2], columns);
+	}
+
+	std::vector<bool> walkable = find_walkable_columns(columns);
+	erode(walkable);
+	keep_largest_area(walkable);
+	build_polygons(walkable);
+	link_polygons();
+
+	search_polygons.assign(polygons.size(), { 0.0f, NO_POLYGON, 0, vec3(0.0f), 0, false });
+	search_number = 0;
+}
+
+std::vector<vec3> NavigationMesh::find_path(const vec3& start, const vec3& goal) {
+	vec3 start_point;
+	vec3 goal_point;
+	const UInt start_polygon = find_closest_polygon(start, start_point);
+	const UInt goal_polygon = find_closest_polygon(goal, goal_point);
+	if ((start_polygon == NO_POLYGON) || (goal_polygon == NO_POLYGON)) { return std::vector<vec3>(); }
+
+	// Polygons are convex, so within one the way is straight
+	if (start_polygon == goal_polygon) { return { start_point, goal_point }; }
+
+	if (++search_number == 0) {
+		for (size_t iter = 0; iter < search_polygons.size(); ++iter) { search_polygons[iter].search_number = 0; }
+		search_number = 1;
+	}
+
+	open_set.clear();
+
+	SearchPolygon& start_search = get_search_polygon(start_polygon);
+	start_search.g = 0.0f;
+	start_search.entry = start_point;
+	open_set.push_back({ distance(start_point, goal_point), start_polygon });
+
+	bool found = false;
+
+	while (!open_set.empty()) {
+		std::pop_heap(open_set.begin(), open_set.end(), is_worse_entry);
+		const UInt current_polygon = open_set.back().polygon;
+		open_set.pop_back();
+
+		SearchPolygon& current = search_polygons[current_polygon];
+		if (current.closed) { continue; }
+
+		if (current_polygon == goal_polygon) {
+			found = true;
+			break;
+		}
+
+		current.closed = true;
+
+		const std::vector<Portal>& portals = polygons[current_polygon].portals;
+		for (size_t portal_iter = 0; portal_iter < portals.size(); ++portal_iter) {
+			const Portal& portal = portals[portal_iter];
+
+			SearchPolygon& neighbour = get_search_polygon(portal.polygon);
+			if (neighbour.closed) { continue; }
+
+			const vec3 entry = (portal.start + portal.end) * 0.5f;
+			const float test_g = current.g + distance(current.entry, entry);
+			if (test_g >= neighbour.g) { continue; }
+
+			neighbour.g = test_g;
+			neighbour.parent = current_polygon;
+			neighbour.portal = static_cast<UInt>(portal_iter);
+			neighbour.entry = entry;
+
+			open_set.push_back({ test_g + distance(entry, goal_point), portal.polygon });
+			std::push_heap(open_set.begin(), open_set.end(), is_worse_entry);
+		}
+	}
+
+	if (!found) { return std::vector<vec3>(); }
+
+	// Walked back from the goal, each portal is ordered left then right as seen from the polygon it is left from
+	std::vector<std::pair<vec3, vec3>> portals;
+	for (UInt iter = goal_polygon; search_polygons[iter].parent != NO_POLYGON; iter = search_polygons[iter].parent) {
+		const UInt parent = search_polygons[iter].parent;
+		const Portal& portal = polygons[parent].portals[search_polygons[iter].portal];
+
+		if (triangle_area(polygons[parent].centre, portal.start, portal.end) < 0.0f) { portals.push_back(std::make_pair(portal.end, portal.start)); }
+		else { portals.push_back(std::make_pair(portal.start, portal.end)); }
+	}
+
+	std::reverse(portals.begin(), portals.end());
+	return pull_string(start_point, goal_point, portals);
+}
+
+bool NavigationMesh::is_walkable(const vec3& position) const {
+	return find_polygon(position) != NO_POLYGON;
+}
+
+void NavigationMesh::rasterise_triangle(const vec3& a, const vec3& b, const vec3& c, std::vector<std::vector<Span>>& columns) const {
+	// Faces could be wound either way, a ceiling is only walked on if it has room above it at the floor anyway
+	const vec3 normal = normalise(cross(b - a, c - a));
+	const bool walkable = std::abs(normal.y) >= std::cos(radians(settings.max_slope));
+
+	const float min_x = std::min(std::min(a.x, b.x), c.x);
+	const float max_x = std::max(std::max(a.x, b.x), c.x);
+	const float min_z = std::min(std::min(a.z, b.z), c.z);
+	const float max_z = std::max(std::max(a.z, b.z), c.z);
+
+	const size_t first_x = static_cast<size_t>(std::max((min_x - origin_x) / settings.cell_size, 0.0f));
+	const size_t first_z = static_cast<size_t>(std::max((min_z - origin_z) / settings.cell_size, 0.0f));
+	const size_t last_x = std::min(static_cast<size_t>(std::max((max_x - origin_x) / settings.cell_size, 0.0f)), width - 1);
+	const size_t last_z = std::min(static_cast<size_t>(std::max((max_z - origin_z) / settings.cell_size, 0.0f)), depth - 1);
+
+	const std::vector<vec3> triangle = { a, b, c };
+	std::vector<vec3> row;
+	std::vector<vec3> clipped;
+	std::vector<vec3> scratch;
+
+	// Cut into a row of columns first, then each column out of that row
+	for (size_t x = first_x; x <= last_x; ++x) {
+		const float cell_min_x = origin_x + (static_cast<float>(x) * settings.cell_size);
+
+		clip_polygon(triangle, 0, cell_min_x, true, scratch);
+		clip_polygon(scratch, 0, cell_min_x + settings.cell_size, false, row);
+		if (row.empty()) { continue; }
+
+		for (size_t z = first_z; z <= last_z; ++z) {
+			const float cell_min_z = origin_z + (static_cast<float>(z) * settings.cell_size);
+
+			clip_polygon(row, 2, cell_min_z, true, scratch);
+			clip_polygon(scratch, 2, cell_min_z + settings.cell_size, false, clipped);
+			if (clipped.empty()) { continue; }
+
+			Span span = { clipped.front().y, clipped.front().y, walkable };
+			for (size_t iter = 1; iter < clipped.size(); ++iter) {
+				span.min = std::min(span.min, clipped[iter].y);
+				span.max = std::max(span.max, clipped[iter].y);
+			}
+
+			columns[get_index(x, z)].push_back(span);
+		}
+	}
+}
+
+std::vector<bool> NavigationMesh::find_walkable_columns(std::vector<std::vector<Span>>& columns) {
+	// Overlapping spans become one, walkable if the top it ends with was reached by a walkable surface
+	for (size_t column_iter = 0; column_iter < columns.size(); ++column_iter) {
+		std::vector<Span>& spans = columns[column_iter];
+		if (spans.size() < 2) { continue; }
+
+		std::sort(spans.begin(), spans.end(), [](const Span& left, const Span& right) { return left.min < right.min; });
+
+		size_t merged = 0;
+		for (size_t iter = 1; iter < spans.size(); ++iter) {
+			Span& current = spans[merged];
+			const Span& next = spans[iter];
+
+			if (next.min > current.max) {
+				spans[++merged] = next;
+				continue;
+			}
+
+			if (std::abs(next.max - current.max) <= settings.max_climb) { current.walkable = current.walkable || next.walkable; }
+			else if (next.max > current.max) { current.walkable = next.walkable; }
+
+			current.max = std::max(current.max, next.max);
+		}
+
+		spans.resize(merged + 1);
+	}
+
+	// The floor is the height most walkable tops share, grouped by how far an agent can climb
+	std::map<int, std::pair<size_t, float>> heights;
+	for (size_t column_iter = 0; column_iter < columns.size(); ++column_iter) {
+		const std::vector<Span>& spans = columns[column_iter];
+
+		for (size_t iter = 0; iter < spans.size(); ++iter) {
+			if (!spans[iter].walkable) { continue; }
+
+			std::pair<size_t, float>& height = heights[static_cast<int>(std::round(spans[iter].max / settings.max_climb))];
+			++height.first;
+			height.second += spans[iter].max;
+		}
+	}
+
+	std::vector<bool> walkable(columns.size(), false);
+	if (heights.empty()) { return walkable; }
+
+	std::map<int, std::pair<size_t, float>>::const_iterator most_common = heights.begin();
+	for (std::map<int, std::pair<size_t, float>>::const_iterator iter = heights.begin(); iter != heights.end(); ++iter) {
+		if (iter->second.first > most_common->second.first) { most_common = iter; }
+	}
+
+	floor_height = most_common->second.second / static_cast<float>(most_common->second.first);
+
+	for (size_t column_iter = 0; column_iter < columns.size(); ++column_iter) {
+		const std::vector<Span>& spans = columns[column_iter];
+
+		for (size_t iter = 0; iter < spans.size(); ++iter) {
+			const Span& span = spans[iter];
+			if (!span.walkable || (std::abs(span.max - floor_height) > settings.max_climb)) { continue; }
+
+			// Spans are sorted, so the next one is the nearest thing overhead
+			if (((iter + 1) < spans.size()) && ((spans[iter + 1].min - span.max) < settings.agent_height)) { continue; }
+
+			walkable[column_iter] = true;
+			break;
+		}
+	}
+
+	return walkable;
+}
+
+void NavigationMesh::erode(std::vector<bool>& walkable) const {
+	const int radius = static_cast<int>(std::ceil(settings.agent_radius / settings.cell_size));
+	if (radius <= 0) { return; }
+
+	// Steps to the nearest column that is not walkable, diagonal steps counting as one
+	std::vector<int> distances(walkable.size(), INT_MAX);
+	std::vector<size_t> frontier;
+
+	for (size_t iter = 0; iter < walkable.size(); ++iter) {
+		if (walkable[iter]) { continue; }
+
+		distances[iter] = 0;
+		frontier.push_back(iter);
+	}
+
+	// Beyond the heightfield's edge counts as not walkable too, queued after the others to keep distances in order
+	for (size_t iter = 0; iter < walkable.size(); ++iter) {
+		const size_t x = iter / depth;
+		const size_t z = iter % depth;
+		if (!walkable[iter] || ((x != 0) && (x != (width - 1)) && (z != 0) && (z != (depth - 1)))) { continue; }
+
+		distances[iter] = 1;
+		frontier.push_back(iter);
+	}
+
+	for (size_t frontier_iter = 0; frontier_iter < frontier.size(); ++frontier_iter) {
+		const size_t current = frontier[frontier_iter];
+		const int next_distance = distances[current] + 1;
+		if (next_distance > radius) { continue; }
+
+		const int x = static_cast<int>(current / depth);
+		const int z = static_cast<int>(current % depth);
+
+		for (int offset_x = -1; offset_x <= 1; ++offset_x) {
+			for (int offset_z = -1; offset_z <= 1; ++offset_z) {
+				const int neighbour_x = x + offset_x;
+				const int neighbour_z = z + offset_z;
+				if ((neighbour_x < 0) || (neighbour_z < 0) || (neighbour_x >= static_cast<int>(width)) || (neighbour_z >= static_cast<int>(depth))) { continue; }
+
+				const size_t neighbour = get_index(static_cast<size_t>(neighbour_x), static_cast<size_t>(neighbour_z));
+				if (distances[neighbour] <= next_distance) { continue; }
+
+				distances[neighbour] = next_distance;
+				frontier.push_back(neighbour);
+			}
+		}
+	}
+
+	for (size_t iter = 0; iter < walkable.size(); ++iter) {
+		if (distances[iter] <= radius) { walkable[iter] = false; }
+	}
+}
+
+void NavigationMesh::keep_largest_area(std::vector<bool>& walkable) const {
+	std::vector<UInt> areas(walkable.size(), NO_POLYGON);
+	std::vector<size_t> frontier;
+	UInt largest_area = NO_POLYGON;
+	size_t largest_size = 0;
+
+	for (size_t iter = 0; iter < walkable.size(); ++iter) {
+		if (!walkable[iter] || (areas[iter] != NO_POLYGON)) { continue; }
+
+		// Flood filled across edges, the same way polygons are linked
+		const UInt area = static_cast<UInt>(iter);
+		areas[iter] = area;
+		frontier.assign(1, iter);
+
+		for (size_t frontier_iter = 0; frontier_iter < frontier.size(); ++frontier_iter) {
+			const size_t current = frontier[frontier_iter];
+			const size_t x = current / depth;
+			const size_t z = current % depth;
+
+			size_t neighbours[4];
+			size_t neighbour_count = 0;
+			if (x > 0)				{ neighbours[neighbour_count++] = get_index(x - 1, z); }
+			if ((x + 1) < width)	{ neighbours[neighbour_count++] = get_index(x + 1, z); }
+			if (z > 0)				{ neighbours[neighbour_count++] = get_index(x, z - 1); }
+			if ((z + 1) < depth)	{ neighbours[neighbour_count++] = get_index(x, z + 1); }
+
+			for (size_t neighbour_iter = 0; neighbour_iter < neighbour_count; ++neighbour_iter) {
+				const size_t neighbour = neighbours[neighbour_iter];
+				if (!walkable[neighbour] || (areas[neighbour] != NO_POLYGON)) { continue; }
+
+				areas[neighbour] = area;
+				frontier.push_back(neighbour);
+			}
+		}
+
+		if (frontier.size() > largest_size) {
+			largest_size = frontier.size();
+			largest_area = area;
+		}
+	}
+
+	for (size_t iter = 0; iter < walkable.size(); ++iter) {
+		if (areas[iter] != largest_area) { walkable[iter] = false; }
+	}
+}
+
+void NavigationMesh::build_polygons(const std::vector<bool>& walkable) {
+	cell_polygons.assign(walkable.size(), NO_POLYGON);
+
+	const size_t max_size = std::max(settings.max_polygon_size, static_cast<size_t>(1));
+
+	for (size_t z = 0; z < depth; ++z) {
+		for (size_t x = 0; x < width; ++x) {
+			if (!walkable[get_index(x, z)] || (cell_polygons[get_index(x, z)] != NO_POLYGON)) { continue; }
+
+			// Grown along x as far as it goes, then along z while every column of the next row is free
+			size_t max_x = x;
+			while (((max_x + 1) < width) && ((max_x + 1 - x) < max_size) && walkable[get_index(max_x + 1, z)] && (cell_polygons[get_index(max_x + 1, z)] == NO_POLYGON)) { ++max_x; }
+
+			size_t max_z = z;
+			while (((max_z + 1) < depth) && ((max_z + 1 - z) < max_size)) {
+				bool row_free = true;
+
+				for (size_t row_x = x; row_x <= max_x; ++row_x) {
+					const size_t index = get_index(row_x, max_z + 1);
+					if (!walkable[index] || (cell_polygons[index] != NO_POLYGON)) {
+						row_free = false;
+						break;
+					}
+				}
+
+				if (!row_free) { break; }
+				++max_z;
+			}
+
+			const UInt polygon = static_cast<UInt>(polygons.size());
+			for (size_t polygon_x = x; polygon_x <= max_x; ++polygon_x) {
+				for (size_t polygon_z = z; polygon_z <= max_z; ++polygon_z) { cell_polygons[get_index(polygon_x, polygon_z)] = polygon; }
+			}
+
+			const vec3 centre(
+				origin_x + (static_cast<float>(x + max_x + 1) * settings.cell_size * 0.5f),
+				floor_height,
+				origin_z + (static_cast<float>(z + max_z + 1) * settings.cell_size * 0.5f)
+			);
+
+			polygons.push_back({ x, z, max_x, max_z, centre, std::vector<Portal>() });
+		}
+	}
+}
+
+void NavigationMesh::link_polygons() {
+	// Each shared edge is found once, from the polygon on its lower side along x or z
+	for (UInt polygon_iter = 0; polygon_iter < polygons.size(); ++polygon_iter) {
+		for (int side = 0; side < 2; ++side) {
+			const bool along_x = (side == 0);
+			const Polygon polygon = polygons[polygon_iter];
+
+			const size_t across = along_x ? (polygon.max_x + 1) : (polygon.max_z + 1);
+			if (across >= (along_x ? width : depth)) { continue; }
+
+			const size_t first = along_x ? polygon.min_z : polygon.min_x;
+			const size_t last = along_x ? polygon.max_z : polygon.max_x;
+			size_t run_start = first;
+
+			for (size_t step = first; step <= (last + 1); ++step) {
+				const UInt current = (step <= last) ? cell_polygons[along_x ? get_index(across, step) : get_index(step, across)] : NO_POLYGON;
+				const UInt previous = (step > run_start) ? cell_polygons[along_x ? get_index(across, step - 1) : get_index(step - 1, across)] : current;
+
+				if ((step > run_start) && (current != previous)) {
+					if (previous != NO_POLYGON) {
+						const float edge = static_cast<float>(across) * settings.cell_size;
+						const float run_min = static_cast<float>(run_start) * settings.cell_size;
+						const float run_max = static_cast<float>(step) * settings.cell_size;
+
+						const vec3 start = along_x ? vec3(origin_x + edge, floor_height, origin_z + run_min) : vec3(origin_x + run_min, floor_height, origin_z + edge);
+						const vec3 end = along_x ? vec3(origin_x + edge, floor_height, origin_z + run_max) : vec3(origin_x + run_max, floor_height, origin_z + edge);
+
+						polygons[polygon_iter].portals.push_back({ previous, start, end });
+						polygons[previous].portals.push_back({ polygon_iter, start, end });
+					}
+
+					run_start = step;
+				}
+			}
+		}
+	}
+}
+
+UInt NavigationMesh::find_polygon(const vec3& position) const {
+	if (cell_polygons.empty()) { return NO_POLYGON; }
+
+	const float column = std::floor((position.x - origin_x) / settings.cell_size);
+	const float row = std::floor((position.z - origin_z) / settings.cell_size);
+	if ((column < 0.0f) || (row < 0.0f) || (column >= static_cast<float>(width)) || (row >= static_cast<float>(depth))) { return NO_POLYGON; }
+
+	return cell_polygons[get_index(static_cast<size_t>(column), static_cast<size_t>(row))];
+}
+
+UInt NavigationMesh::find_closest_polygon(const vec3& position, vec3& closest_point) const {
+	closest_point = vec3(position.x, floor_height, position.z);
+
+	const UInt polygon = find_polygon(position);
+	if (polygon != NO_POLYGON) { return polygon; }
+
+	UInt closest = NO_POLYGON;
+	float closest_distance = 0.0f;
+
+	// Polygons are rectangles, so the closest point in each is the position clamped to it
+	// Kept a hundredth of a column inside the far edges, which belong to the next column
+	const float inset = settings.cell_size * 0.01f;
+
+	for (size_t iter = 0; iter < polygons.size(); ++iter) {
+		const Polygon& candidate = polygons[iter];
+
+		const float min_x = origin_x + (static_cast<float>(candidate.min_x) * settings.cell_size);
+		const float min_z = origin_z + (static_cast<float>(candidate.min_z) * settings.cell_size);
+		const float max_x = origin_x + (static_cast<float>(candidate.max_x + 1) * settings.cell_size) - inset;
+		const float max_z = origin_z + (static_cast<float>(candidate.max_z + 1) * settings.cell_size) - inset;
+
+		const vec3 point(std::min(std::max(position.x, min_x), max_x), floor_height, std::min(std::max(position.z, min_z), max_z));
+		const float point_distance = ((point.x - position.x) * (point.x - position.x)) + ((point.z - position.z) * (point.z - position.z));
+
+		if ((closest == NO_POLYGON) || (point_distance < closest_distance)) {
+			closest = static_cast<UInt>(iter);
+			closest_distance = point_distance;
+			closest_point = point;
+		}
+	}
+
+	return closest;
+}
+
+NavigationMesh::SearchPolygon& NavigationMesh::get_search_polygon(const UInt& polygon) {
+	SearchPolygon& search_polygon = search_polygons[polygon];
+
+	if (search_polygon.search_number != search_number) {
+		search_polygon = { std::numeric_limits<float>::max(), NO_POLYGON, 0, vec3(0.0f), search_number, false };
+	}
+
+	return search_polygon;
+}
+
+std::vector<vec3> NavigationMesh::pull_string(const vec3& start, const vec3& goal, const std::vector<std::pair<vec3, vec3>>& portals) const {
+	// The funnel starts at the start and ends at the goal, both as portals of no width
+	std::vector<std::pair<vec3, vec3>> funnel_portals = { std::make_pair(start, start) };
+	funnel_portals.insert(funnel_portals.end(), portals.begin(), portals.end());
+	funnel_portals.push_back(std::make_pair(goal, goal));
+
+	std::vector<vec3> corners = { start };
+
+	vec3 apex = start;
+	vec3 left = start;
+	vec3 right = start;
+	size_t apex_index = 0;
+	size_t left_index = 0;
+	size_t right_index = 0;
+
+	// The funnel is narrowed portal by portal, when one side crosses the other its end is a corner and the funnel restarts there
+	for (size_t iter = 1; iter < funnel_portals.size(); ++iter) {
+		const vec3& portal_left = funnel_portals[iter].first;
+		const vec3& portal_right = funnel_portals[iter].second;
+
+		if (triangle_area(apex, right, portal_right) <= 0.0f) {
+			if ((apex == right) || (triangle_area(apex, left, portal_right) > 0.0f)) {
+				right = portal_right;
+				right_index = iter;
+
+			} else {
+				apex = left;
+				apex_index = left_index;
+				corners.push_back(apex);
+
+				left = apex;
+				right = apex;
+				left_index = apex_index;
+				right_index = apex_index;
+				iter = apex_index;
+				continue;
+			}
+		}
+
+		if (triangle_area(apex, left, portal_left) >= 0.0f) {
+			if ((apex == left) || (triangle_area(apex, right, portal_left) < 0.0f)) {
+				left = portal_left;
+				left_index = iter;
+
+			} else {
+				apex = right;
+				apex_index = right_index;
+				corners.push_back(apex);
+
+				left = apex;
+				right = apex;
+				left_index = apex_index;
+				right_index = apex_index;
+				iter = apex_index;
+				continue;
+			}
+		}
+	}
+
+	if (corners.back() != goal) { corners.push_back(goal); }
+	return corners;
+}
+
+float NavigationMesh::triangle_area(const vec3& a, const vec3& b, const vec3& c) {
+	return ((c.x - a.x) * (b.z - a.z)) - ((b.x - a.x) * (c.z - a.z));
+}
+
+bool NavigationMesh::is_worse_entry(const OpenEntry& left, const OpenEntry& right) {
+	return left.f > right.f;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Model.hpp"
+
+
+struct NavigationMeshSettings {
+	float cell_size = 1.0f;			// Width of a heightfield column, in world units
+	float agent_height = 2.0f;		// Clearance needed above a floor
+	float agent_radius = 1.0f;		// Walkable area is shrunk by this much away from obstacles
+	float max_climb = 0.5f;			// Largest step still counted as the same floor
+	float max_slope = 45.0f;		// Degrees from flat
+	size_t max_polygon_size = 16;	// Columns along either side, larger polygons make costs between them less accurate
+};
+
+
+class NavigationMesh {
+	/*
+	Walkable area found from a model's triangles, searched as polygons rather than grid nodes
+
+	Triangles are voxelised into a heightfield: each is clipped against every column it covers,
+	leaving a span of solid between its lowest and highest points there. A column is walkable
+	where a gently sloped span tops out at the floor, the most common walkable height, with room
+	for an agent above it. The walkable area is then shrunk away from obstacles by the agent's
+	radius, so agents can be treated as points from here on. Only the largest connected area is
+	kept, the others being the insides of closed obstacles or places agents could never reach.
+
+	Walkable columns are merged greedily into rectangles rather than traced into contours and
+	triangulated. Rectangles are convex, so a straight line joins any two points in one, and
+	neighbouring rectangles are linked through the edges they share.
+
+	Paths are searched over rectangles with A*, costed between the middles of shared edges, and
+	are then pulled tight through those edges with the funnel algorithm, leaving only corners
+	*/
+
+public:
+	NavigationMesh(const NavigationMeshSettings& settings = NavigationMeshSettings());
+
+	NavigationMesh(const NavigationMesh& other) = delete;
+	void operator=(const NavigationMesh& other) = delete;
+
+	// Replaces anything built before, the model is taken as it is currently transformed
+	void build(Model& model);
+	void build(const std::vector<vec3>& triangles);	// Each three points are a triangle, in world space
+
+	// Corners at floor height from the start to the goal, both included
+	// Ends off the mesh (such as within the agent radius of an obstacle) are moved to the closest point on it first,
+	// so only a mesh that has not been built gives an empty path
+	std::vector<vec3> find_path(const vec3& start, const vec3& goal);
+
+	// Only x and z are used
+	bool is_walkable(const vec3& position) const;
+
+	inline size_t get_polygon_count() const { return polygons.size(); }
+	inline float get_floor_height() const { return floor_height; }
+
+private:
+	static const UInt NO_POLYGON = UINT_MAX;
+
+	struct Span {
+		float min;
+		float max;
+		bool walkable;
+	};
+
+	struct Portal {
+		UInt polygon;	// The polygon on the other side
+		vec3 start;		// Ends of the shared edge
+		vec3 end;
+	};
+
+	struct Polygon {
+		// Inclusive columns (x) and rows (z) of the rectangle
+		size_t min_x;
+		size_t min_z;
+		size_t max_x;
+		size_t max_z;
+
+		vec3 centre;
+		std::vector<Portal> portals;
+	};
+
+	struct SearchPolygon {
+		float g;
+		UInt parent;
+		UInt portal;		// Which of the parent's portals was crossed
+		vec3 entry;			// Where the polygon was entered, the middle of that portal
+		UInt search_number;	// The search that last wrote this, older values are stale
+		bool closed;
+	};
+
+	struct OpenEntry {
+		float f;
+		UInt polygon;
+	};
+
+	NavigationMeshSettings settings;
+
+	float origin_x = 0.0f;
+	float origin_z = 0.0f;
+	size_t width = 0;	// Columns along x
+	size_t depth = 0;	// Rows along z
+	float floor_height = 0.0f;
+
+	std::vector<UInt> cell_polygons;	// Column major, NO_POLYGON where the column is not walkable
+	std::vector<Polygon> polygons;
+
+	std::vector<SearchPolygon> search_polygons;
+	std::vector<OpenEntry> open_set;
+	UInt search_number = 0;
+
+	void rasterise_triangle(const vec3& a, const vec3& b, const vec3& c, std::vector<std::vector<Span>>& columns) const;
+	std::vector<bool> find_walkable_columns(std::vector<std::vector<Span>>& columns);
+	void erode(std::vector<bool>& walkable) const;
+	void keep_largest_area(std::vector<bool>& walkable) const;
+	void build_polygons(const std::vector<bool>& walkable);
+	void link_polygons();
+
+	UInt find_polygon(const vec3& position) const;
+	UInt find_closest_polygon(const vec3& position, vec3& closest_point) const;	// The position itself when it is on the mesh
+	SearchPolygon& get_search_polygon(const UInt& polygon);
+
+	// Portals are given as their left and right ends, as seen when crossing them
+	std::vector<vec3> pull_string(const vec3& start, const vec3& goal, const std::vector<std::pair<vec3, vec3>>& portals) const;
+
+	inline size_t get_index(const size_t& x, const size_t& z) const { return (x * depth) + z; }
+
+	// Twice the signed area of the triangle in x and z, which side of the line from a to b that c is on
+	static float triangle_area(const vec3& a, const vec3& b, const vec3& c);
+	static bool is_worse_entry(const OpenEntry& left, const OpenEntry& right);
+};
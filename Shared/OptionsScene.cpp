@@ -15,14 +15,18 @@ top_column(column_length, column_width, column_width),
 bottom_column(column_length, column_width, column_width),
 background(background_dimension, background_dimension, column_width),
 initial_multisampling(window->get_multisample_rate()),
+post_process(window->width(), window->height()),
 title(GameConstants::MECHA(), "Options"),
 return_to_main_menu(GameConstants::MECHA(), "Main Menu"),
 fullscreen(GameConstants::MECHA(), "Fullscreen:"),
 fullscreen_status(GameConstants::MECHA(), ""),
 multisampling(GameConstants::MECHA(), "Multisampling:"),
 multisample_value(GameConstants::MECHA(), ""),
+anti_aliasing(GameConstants::MECHA(), "Anti-aliasing:"),
+anti_aliasing_status(GameConstants::MECHA(), ""),
 shadows(GameConstants::MECHA(), "Shadows:"),
 shadow_status(GameConstants::MECHA(), ""),
+calibrate(GameConstants::MECHA(), "Calibrate Settings"),
 effect(GameConstants::MECHA(), "Restart game for change in multisampling") {
 
 	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()));
@@ -33,8 +37,8 @@ effect(GameConstants::MECHA(), "Restart game for change in multisampling") {
 	setup_framebuffer();
 
     Program& shape_program = ResourceHandler::get_instance().get_program(Shape::GENERIC_ID());
-	shape_program.set_uniform<float>("far_plane", GameConstants::far_plane);
-	shape_program.set_uniform<bool>("use_light_colour", true);
+	shape_program.set_persistent_uniform<float>("far_plane", GameConstants::far_plane);
+	if (light_program) { light_program->set_feature(LightMapFeatures::LIGHT_COLOUR, true); }
 }
 
 void OptionsScene::bind_callbacks(){
@@ -67,12 +71,12 @@ void OptionsScene::pre_render(){
 	handle_held_keys();
 
 	LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Cube::GENERIC_ID()));
-	light_program->set_uniform<bool>("use_shadows", use_shadows);
+	light_program->set_feature(LightMapFeatures::SHADOWS, use_shadows);
 
 	if (using_shadows()) {
 		glActiveTexture(GL_TEXTURE31);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, cube_map);
-		ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_uniform<int>("depth_map", 31);
+		ResourceHandler::get_instance().get_program(Shape::GENERIC_ID()).set_persistent_uniform<int>("depth_map", 31);
         
         render_framebuffer();
 	}
@@ -83,8 +87,10 @@ void OptionsScene::pre_render(){
     
 	switch (choice) {
 		case (OptionsMenuChoices::RETURN_TO_MAIN_MENU) : { return_to_main_menu.set_colour(colour); break; }
+		case (OptionsMenuChoices::CALIBRATE) : { calibrate.set_colour(colour); break; }
 		case (OptionsMenuChoices::FULLSCREEN) : { fullscreen_status.set_colour(colour); break; }
 		case (OptionsMenuChoices::MULTISAMPLING) : { multisample_value.set_colour(colour); break; }
+		case (OptionsMenuChoices::ANTI_ALIASING) : { anti_aliasing_status.set_colour(colour); break; }
 		case (OptionsMenuChoices::SHADOWS) : { shadow_status.set_colour(colour); break; }
 	}
     
@@ -96,6 +102,7 @@ void OptionsScene::pre_render(){
 
 	AttributeParser parser(FileSystem::join(FileSystem::get_resource_dir(), "OPTIONS").string());
 	use_shadows = parser.get_attribute(Options::SHADOWS) == "On" ? true : false;
+	use_fxaa = parser.get_attribute(Options::ANTI_ALIASING) == "FXAA" ? true : false;
 }
 
 void OptionsScene::render(){
@@ -105,17 +112,15 @@ void OptionsScene::render(){
 	const mat4 vp = perspective(GameConstants::FOV, aspect_ratio, GameConstants::near_plane, GameConstants::far_plane) * view_matrix;
     
     ResourceHandler& instance = ResourceHandler::get_instance();
-	instance.get_program(Shape::GENERIC_ID()).set_uniform<mat4>("VP", vp);
-	instance.get_program(Shape::GENERIC_ID()).set_uniform<vec3>("view_position", camera->get_position());
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<mat4>("VP", vp);
+	instance.get_program(Shape::GENERIC_ID()).set_persistent_uniform<vec3>("view_position", camera->get_position());
 	instance.get_program("3DText").set_uniform<mat4>("VP", vp);
 
+	if (use_fxaa) { post_process.begin(window_dimensions.first, window_dimensions.second); }
+
 	for (size_t iter = 0; iter < renderables.size(); ++iter) { renderables.at(iter)->render(); }
 
-	dynamic_cast<Renderable*>(&left_column)->render();
-	dynamic_cast<Renderable*>(&right_column)->render();
-	dynamic_cast<Renderable*>(&top_column)->render();
-	dynamic_cast<Renderable*>(&bottom_column)->render();
-	dynamic_cast<Renderable*>(&background)->render();
+	static_geometry.render(Shape::GENERIC_ID());
 
 	title.render("3DText");
 	return_to_main_menu.render("3DText");
@@ -123,8 +128,11 @@ void OptionsScene::render(){
 	fullscreen_status.render("3DText");
 	multisampling.render("3DText");
 	multisample_value.render("3DText");
+	anti_aliasing.render("3DText");
+	anti_aliasing_status.render("3DText");
 	shadows.render("3DText");
 	shadow_status.render("3DText");
+	calibrate.render("3DText");
 	if (render_effect) { effect.render("3DText"); }
 	glCullFace(GL_FRONT);
 
@@ -134,10 +142,15 @@ void OptionsScene::render(){
 	fullscreen_status.render("3DText");
 	multisampling.render("3DText");
 	multisample_value.render("3DText");
+	anti_aliasing.render("3DText");
+	anti_aliasing_status.render("3DText");
 	shadows.render("3DText");
 	shadow_status.render("3DText");
+	calibrate.render("3DText");
 	if (render_effect) { effect.render("3DText"); }
 	glCullFace(GL_BACK);
+
+	if (use_fxaa) { post_process.end(window_dimensions.first, window_dimensions.second); }
 }
 
 // Member Functions
@@ -153,6 +166,11 @@ void OptionsScene::update_multisample_value() {
 	render_effect = std::stoi(parser.get_attribute(Options::MULTISAMPLING)) != initial_multisampling;
 }
 
+void OptionsScene::update_anti_aliasing_value() {
+	anti_aliasing_status.set_text(parser.get_attribute(Options::ANTI_ALIASING));
+	anti_aliasing_status.set_position(vec3(right_column.get_position().x - anti_aliasing_status.get_width() - 1, anti_aliasing_text_height, -35.0f));
+}
+
 void OptionsScene::update_shadows_value() {
 	std::string shadows = parser.get_attribute(Options::SHADOWS);
 
@@ -238,6 +256,14 @@ void OptionsScene::init(){
 	multisample_value.set_colour(Colours::BLACK);
 	update_multisample_value();
 
+	anti_aliasing.set_scale(0.02f);
+	anti_aliasing.set_position(vec3(left_column.get_position().x + 1.0f, anti_aliasing_text_height, -35.0f));
+	anti_aliasing.set_colour(Colours::BLACK);
+
+	anti_aliasing_status.set_scale(0.02f);
+	anti_aliasing_status.set_colour(Colours::BLACK);
+	update_anti_aliasing_value();
+
 	shadows.set_scale(0.02f);
 	shadows.set_position(vec3(left_column.get_position().x + 1.0f, shadow_text_height, -35.0f));
 	shadows.set_colour(Colours::BLACK);
@@ -246,10 +272,23 @@ void OptionsScene::init(){
 	shadow_status.set_colour(Colours::BLACK);
 	update_shadows_value();
 
+	calibrate.set_scale(0.02f);
+	calibrate.set_position(vec3(0.0f, calibrate_text_height, -35.0f));
+	calibrate.set_horisontal_align();
+	calibrate.set_colour(Colours::BLACK);
+
 	effect.set_colour(Colours::CRIMSON);
 	effect.set_scale(0.015f);
 	effect.set_position(vec3(0.0f, bottom_column.get_position().y - 8.0f, -35.0f));
 	effect.set_horisontal_align();
+
+	// Merged only once every cuboid has its final position and texture
+	static_geometry.add(left_column);
+	static_geometry.add(right_column);
+	static_geometry.add(top_column);
+	static_geometry.add(bottom_column);
+	static_geometry.add(background);
+	static_geometry.build();
 }
 
 void OptionsScene::change_choice(bool value) {
@@ -273,6 +312,14 @@ void OptionsScene::change_choice(bool value) {
 			break;
 		}
 
+		case (OptionsMenuChoices::ANTI_ALIASING) : {
+			anti_aliasing_status.set_colour(Colours::BLACK);
+			if (value) { choice = static_cast<EnumType>(static_cast<int>(choice) + 1); }
+			else { choice = static_cast<EnumType>(static_cast<int>(choice) - 1); }
+
+			break;
+		}
+
 		case (OptionsMenuChoices::FULLSCREEN) : {
 			fullscreen_status.set_colour(Colours::BLACK);
 			if (value) { choice = static_cast<EnumType>(static_cast<int>(choice) + 1); }
@@ -281,6 +328,14 @@ void OptionsScene::change_choice(bool value) {
 			break;
 		}
 
+		case (OptionsMenuChoices::CALIBRATE) : {
+			calibrate.set_colour(Colours::BLACK);
+			if (value) { choice = static_cast<EnumType>(static_cast<int>(choice) + 1); }
+			else { choice = static_cast<EnumType>(static_cast<int>(choice) - 1); }
+
+			break;
+		}
+
 		case (OptionsMenuChoices::RETURN_TO_MAIN_MENU) : {
 			return_to_main_menu.set_colour(Colours::BLACK);
 			if (value) { choice = OptionsMenuChoices::FIRST; }
@@ -294,6 +349,7 @@ void OptionsScene::change_choice(bool value) {
 void OptionsScene::select_choice() {
 	switch (choice) {
 		case (OptionsMenuChoices::RETURN_TO_MAIN_MENU) : { return_code = OptionsReturnCodes::MAIN_MENU; break; }
+		case (OptionsMenuChoices::CALIBRATE) : { return_code = OptionsReturnCodes::CALIBRATE; break; }
 
 		case (OptionsMenuChoices::SHADOWS) : {
 			parser.change_attribute(Options::SHADOWS, use_shadows ? "Off" : "On");
@@ -303,6 +359,15 @@ void OptionsScene::select_choice() {
 			break;
 		}
 
+		case (OptionsMenuChoices::ANTI_ALIASING) : {
+			// Unlike multisampling this takes effect straight away
+			parser.change_attribute(Options::ANTI_ALIASING, use_fxaa ? "Off" : "FXAA");
+			use_fxaa = !use_fxaa;
+			update_anti_aliasing_value();
+
+			break;
+		}
+
 		case (OptionsMenuChoices::FULLSCREEN) : { 
 			parser.change_attribute(Options::FULLSCREEN, window->get_is_fullscreen() ? "Off" : "On");
 			window->set_fullscreen(!window->get_is_fullscreen());
@@ -402,11 +467,7 @@ void OptionsScene::render_framebuffer() {
 		renderable->render("Shadow");
 	}
 
-	left_column.render("Shadow");
-	right_column.render("Shadow");
-	top_column.render("Shadow");
-	bottom_column.render("Shadow");
-	background.render("Shadow");
+	static_geometry.render("Shadow");
 
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -1,15 +1,19 @@
 #pragma once
 #include "BaseScene.hpp"
 #include "Cuboid.hpp"
+#include "StaticBatch.hpp"
 #include "Text.hpp"
 #include "WindowWrapper.hpp"
 #include "AttributeParser.hpp"
+#include "PostProcess.hpp"
 
 
 enum OptionsMenuChoices {
 	SHADOWS,
 	MULTISAMPLING,
+	ANTI_ALIASING,
 	FULLSCREEN,
+	CALIBRATE,
 	RETURN_TO_MAIN_MENU,
 
 	FIRST = SHADOWS,
@@ -20,6 +24,7 @@ enum OptionsMenuChoices {
 class OptionsReturnCodes : public ReturnCodes {
 public:
     static const EnumType MAIN_MENU = 6;
+	static const EnumType CALIBRATE = 8;
 };
 
 
@@ -29,9 +34,11 @@ private:
 	const float column_width = 1.0f;
 	const float column_length = 31.0f;
 	const float background_dimension = 65.0f;
-	const float fullscreen_text_height = -6.0f;
-	const float multisample_text_height = -2.0f;
-	const float shadow_text_height = 2.0f;
+	const float calibrate_text_height = -8.0f;
+	const float fullscreen_text_height = -4.0f;
+	const float anti_aliasing_text_height = -1.0f;
+	const float multisample_text_height = 2.0f;
+	const float shadow_text_height = 5.0f;
 
 public:
     // Constructors and Destructors
@@ -72,13 +79,20 @@ private:
     UInt cube_map;
 	EnumType choice = OptionsMenuChoices::LAST;
     bool use_shadows = true;
+	bool use_fxaa = false;
 	int initial_multisampling;
+
+	// Applied here as well so that the change can be seen straight away
+	PostProcess post_process;
     
     Cuboid left_column;
     Cuboid right_column;
     Cuboid top_column;
     Cuboid bottom_column;
     Cuboid background;
+
+    // The five cuboids above merged, they never move after init
+    StaticBatch static_geometry;
     
     Text title;
 	Text return_to_main_menu;
@@ -89,9 +103,14 @@ private:
 	Text multisampling;
 	Text multisample_value;
 
+	Text anti_aliasing;
+	Text anti_aliasing_status;
+
 	Text shadows;
 	Text shadow_status;
 
+	Text calibrate;
+
 	Text effect;
 	bool render_effect = false;
 
@@ -111,6 +130,7 @@ private:
 
 	void update_fullscreen_status();
 	void update_multisample_value();
+	void update_anti_aliasing_value();
 	void update_shadows_value();
 
 public:
@@ -0,0 +1,80 @@
+#include "PathfindingPool.hpp"
+
+
+PathfindingPool::PathfindingPool(Map& map, const size_t& thread_count) : map(map) {
+	size_t count = thread_count;
+
+	if (count == 0) {
+		// hardware_concurrency() is 0 when it cannot be told
+		const size_t hardware_threads = static_cast<size_t>(std::thread::hardware_concurrency());
+		count = (hardware_threads > 1) ? (hardware_threads - 1) : 1;
+	}
+
+	for (size_t iter = 0; iter < count; ++iter) {
+		workers.push_back(std::thread(&PathfindingPool::work, this));
+	}
+}
+
+PathfindingPool::~PathfindingPool() {
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex);
+		stopping = true;
+	}
+
+	queue_condition.notify_all();
+
+	for (size_t iter = 0; iter < workers.size(); ++iter) { workers.at(iter).join(); }
+}
+
+std::future<std::vector<Node*>> PathfindingPool::request_path(Node* start_node, Node* end_node, const bool use_jump_points) {
+	Request request = { start_node, end_node, use_jump_points, std::promise<std::vector<Node*>>() };
+	std::future<std::vector<Node*>> path = request.path.get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex);
+		requests.push_back(std::move(request));
+	}
+
+	queue_condition.notify_one();
+	return path;
+}
+
+void PathfindingPool::wait_until_idle() {
+	std::unique_lock<std::mutex> lock(queue_mutex);
+	idle_condition.wait(lock, [this]() { return requests.empty() && (running == 0); });
+}
+
+bool PathfindingPool::is_ready(const std::future<std::vector<Node*>>& path) {
+	return path.valid() && (path.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
+void PathfindingPool::work() {
+	Map::SearchContext context;
+
+	for (;;) {
+		Request request;
+
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex);
+			queue_condition.wait(lock, [this]() { return stopping || !requests.empty(); });
+			if (stopping) { return; }
+
+			request = std::move(requests.front());
+			requests.pop_front();
+			++running;
+		}
+
+		// Searched outside the lock, the context is this thread's alone and the map is only read
+		request.path.set_value(map.smooth_path(request.use_jump_points ?
+			map.jump_point_pathfind(context, request.start_node, request.end_node) :
+			map.a_star_pathfind(context, request.start_node, request.end_node)));
+
+		bool idle;
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			idle = (--running == 0) && requests.empty();
+		}
+
+		if (idle) { idle_condition.notify_all(); }
+	}
+}
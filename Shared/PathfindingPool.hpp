@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Map.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <deque>
+
+
+class PathfindingPool {
+	/*
+	Worker threads that search a Map in the background
+
+	Each worker keeps a search context of its own, so queued searches run side by side and the
+	thread asking never waits for them: it holds on to the future and takes the path once it is
+	ready, normally on a later frame.
+
+	Walls must not change while searches are queued or running, and the map must outlive the pool
+	*/
+
+public:
+	// A thread count of 0 uses one less than the hardware has, leaving one for the main thread, but always at least one
+	PathfindingPool(Map& map, const size_t& thread_count = 0);
+	~PathfindingPool();	// Searches still queued are abandoned, their futures throw std::future_error
+
+	PathfindingPool(const PathfindingPool& other) = delete;
+	void operator=(const PathfindingPool& other) = delete;
+
+	// Paths come back smoothed, only the nodes where they turn are kept
+	std::future<std::vector<Node*>> request_path(Node* start_node, Node* end_node, const bool use_jump_points = false);
+
+	// Blocks until every queued search has finished, so that walls can be changed safely
+	void wait_until_idle();
+
+	inline size_t get_thread_count() const { return workers.size(); }
+
+	// Whether the future holds a path that can be taken without waiting
+	static bool is_ready(const std::future<std::vector<Node*>>& path);
+
+private:
+	struct Request {
+		Node* start_node;
+		Node* end_node;
+		bool use_jump_points;
+		std::promise<std::vector<Node*>> path;
+	};
+
+	Map& map;
+	std::vector<std::thread> workers;
+
+	std::mutex queue_mutex;
+	std::condition_variable queue_condition;
+	std::deque<Request> requests;
+	size_t running = 0;		// Searches taken from the queue and not yet finished
+	bool stopping = false;
+
+	std::condition_variable idle_condition;
+
+	void work();
+};
@@ -163,41 +163,41 @@ void Player::enemy_hit() {
 }
 
 void Player::render(){
-	std::pair<UInt, UInt> dim = WindowWrapper::get_instance().get_window_dimensions();
-	vec3 centre(dim.first / 2.0f, dim.second / 2.0f, 0.0f);
-
-    ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()).set_uniform<bool>("use_light_colour", false);
+    LightMapProgram* light_program = dynamic_cast<LightMapProgram*>(&ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()));
+    light_program->set_feature(LightMapFeatures::LIGHT_COLOUR, false);
     if (!first_person) { dynamic_cast<Renderable*>(&cuboid)->render(); }
     
     for (size_t i = 0; i < projectiles.size(); ++i){
         projectiles.at(i)->render();
     }
     
-    ResourceHandler::get_instance().get_program(Mesh::GENERIC_ID()).set_uniform<bool>("use_light_colour", true);
-    
-    vertical_crosshair.render("OrthoShape");
-    horisontal_crosshair.render("OrthoShape");
+    light_program->set_feature(LightMapFeatures::LIGHT_COLOUR, true);
+}
+
+void Player::submit_hud(RenderQueue& queue) {
+    queue.submit_overlay(vertical_crosshair, "OrthoShape");
+    queue.submit_overlay(horisontal_crosshair, "OrthoShape");
     
     mana_text.set_text("Mana: " + std::to_string(mana));
 	mana_text.set_horisontal_align();
-    dynamic_cast<Renderable*>(&mana_text)->render();
+    queue.submit_overlay(mana_text);
 
     health_text.set_text("Health: " + std::to_string(health));
 	health_text.set_horisontal_align();
-    dynamic_cast<Renderable*>(&health_text)->render();
+    queue.submit_overlay(health_text);
     
 	score_text.set_horisontal_align();
-    dynamic_cast<Renderable*>(&score_text)->render();
+    queue.submit_overlay(score_text);
     
-    dynamic_cast<Renderable*>(&potato_text)->render();
-    dynamic_cast<Renderable*>(&fireball_text)->render();
-    dynamic_cast<Renderable*>(&iceball_text)->render();
-    dynamic_cast<Renderable*>(&magic_text)->render();
+    queue.submit_overlay(potato_text);
+    queue.submit_overlay(fireball_text);
+    queue.submit_overlay(iceball_text);
+    queue.submit_overlay(magic_text);
     
-    potato_icon.render("OrthoShape");
-    fireball_icon.render("OrthoShape");
-    iceball_icon.render("OrthoShape");
-    magic_icon.render("OrthoShape");
+    queue.submit_overlay(potato_icon, "OrthoShape");
+    queue.submit_overlay(fireball_icon, "OrthoShape");
+    queue.submit_overlay(iceball_icon, "OrthoShape");
+    queue.submit_overlay(magic_icon, "OrthoShape");
 }
 
 void Player::update(const float& time_delta){
@@ -216,6 +216,7 @@ void Player::update(const float& time_delta){
         Transformable* projectile = dynamic_cast<Transformable*>(projectiles.at(i)->get_projectile_cube());
         projectile->move_by_vector();
         projectile->rotate_all_axis(get_random<float>(0.0f, 360.0f) * time_delta, 0.0f, get_random<float>(0.0f, 360.0f) * time_delta);
+        projectiles.at(i)->update_trail();
     }
     
     for (size_t i = 0; i < projectiles.size(); ++i){
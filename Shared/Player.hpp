@@ -5,6 +5,7 @@
 #include "Projectile.hpp"
 #include "Text.hpp"
 #include "Node.hpp"
+#include "RenderQueue.hpp"
 
 
 class Player : public Character {
@@ -25,6 +26,7 @@ public:
     void increment_score();
     
     void render();
+	void submit_hud(RenderQueue& queue);	// Crosshair, stats and ability icons, drawn over the scene
     void fire_ability();
     void next_ability();
     
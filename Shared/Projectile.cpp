@@ -1,5 +1,6 @@
 #include "Projectile.hpp"
 #include "GameHelpers.hpp"
+#include "ParticleSystem.hpp"
 
 
 const UInt Potato::mana_cost = 0;
@@ -25,11 +26,23 @@ Projectile::Projectile(const vec3& movement_vector, const float& speed) : projec
     projectile_cube.set_move_vector(normalise(movement_vector) * speed);
 }
 
+Projectile::~Projectile() {
+    // Particles already emitted are left to fade out
+    ParticleSystem::get_instance().stop_emitter(trail);
+}
+
+void Projectile::update_trail() {
+    if (trail < 0) { return; }
+    ParticleSystem::get_instance().set_emitter_position(trail, projectile_cube.get_position());
+}
+
 void Projectile::update(const float& time_delta){
     projectile_cube.move(projectile_cube.get_move_vector() * time_delta);
 }
 
 void Projectile::render(){
+    // Projectiles with a trail are drawn entirely by its particles
+    if (trail >= 0) { return; }
     dynamic_cast<Renderable*>(&projectile_cube)->render();
 }
 
@@ -48,12 +61,36 @@ void Potato::render() {
 FireBall::FireBall(const vec3& movement_vector) : Projectile(movement_vector, FireBall::speed) {
     projectile_cube.set_texture(Shape::load_texture_from_file("fireball.png", FileSystem::get_textures_dir().string()));
     projectile_cube.set_enlargement(vec3(0.75f));
+
+    ParticleEmitter flames = {
+        projectile_cube.get_position(),
+        vec3(0.0f, 1.5f, 0.0f),
+        vec3(1.0f, 0.45f, 0.1f),
+        1.0f,
+        0.6f,
+        0.35f,
+        0.0f
+    };
+
+    trail = ParticleSystem::get_instance().add_emitter(flames);
 }
 
 IceBall::IceBall(const vec3& movement_vector) : Projectile(movement_vector, IceBall::speed) {
     projectile_cube.set_texture(Shape::load_texture_from_rgba(0.0f, 0.81f, 0.82f));
     projectile_cube.set_texture(Shape::load_texture_from_file("iceball.png", FileSystem::get_textures_dir().string()));
     projectile_cube.set_enlargement(vec3(1.5f));
+
+    ParticleEmitter shards = {
+        projectile_cube.get_position(),
+        vec3(0.0f),
+        vec3(0.6f, 0.9f, 1.0f),
+        1.5f,
+        0.8f,
+        0.12f,
+        9.8f
+    };
+
+    trail = ParticleSystem::get_instance().add_emitter(shards);
 }
 
 Magic::Magic(const vec3& movement_vector) : Projectile(movement_vector, Magic::speed) {
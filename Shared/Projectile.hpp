@@ -23,10 +23,13 @@ public:
     void operator=(const Projectile& other) = delete;
     
 public:
-    virtual ~Projectile() {}
+    virtual ~Projectile();
     
     void update(const float& time_delta);
-    virtual void render();
+    virtual void render();	// Only the cube, and only when there is no trail to draw the projectile instead
+
+    // Once per frame after the projectile has moved, never from render() as a frame has several passes
+    void update_trail();
     
     Cube* get_projectile_cube() { return &projectile_cube; }
     Collidable get_collidable() { return Collidable::make_collidable(projectile_cube); }
@@ -35,6 +38,9 @@ public:
 protected:
     Projectile(const vec3& movement_vector, const float& speed);
     Cube projectile_cube;
+
+    // Particle emitter handle, -1 if the projectile has no trail
+    int trail = -1;
 };
 
 // ==== ==== ==== ====
@@ -0,0 +1,11 @@
+#version 330 core
+
+in vec2 texture_coords;
+
+out vec4 colour;
+
+uniform sampler2D scene;
+
+void main() {
+	colour = vec4(texture(scene, texture_coords).rgb, 1.0f);
+}
@@ -0,0 +1,11 @@
+#version 330 core
+
+out vec2 texture_coords;
+
+// Single triangle covering the screen, generated without any vertex buffer
+void main() {
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+
+	texture_coords = position;
+	gl_Position = vec4(position * 2.0f - 1.0f, 0.0f, 1.0f);
+}
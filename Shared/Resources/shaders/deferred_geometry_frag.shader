@@ -0,0 +1,47 @@
+#version 330 core
+
+struct CustomMaterial {
+    sampler2D texture_diffuse;
+    sampler2D texture_specular;
+    lowp float shininess;
+};
+
+in Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 texture_coords;
+} vertex;
+
+layout (location = 0) out vec4 albedo_specular;
+layout (location = 1) out vec4 normal_shininess;
+layout (location = 2) out vec4 position;
+
+uniform CustomMaterial material;
+
+// Fraction of the surface handed over to its impostor, 0 (the default) draws all of it
+uniform float fade_out;
+
+// Must match the threshold in impostor_frag.shader
+float dither_threshold(vec2 pixel) {
+    const float bayer[16] = float[](
+        0.0f, 8.0f, 2.0f, 10.0f,
+        12.0f, 4.0f, 14.0f, 6.0f,
+        3.0f, 11.0f, 1.0f, 9.0f,
+        15.0f, 7.0f, 13.0f, 5.0f
+    );
+
+    ivec2 index = ivec2(mod(pixel, 4.0f));
+    return (bayer[index.y * 4 + index.x] + 0.5f) / 16.0f;
+}
+
+void main() {
+	lowp vec4 diffuse_tex = texture(material.texture_diffuse, vertex.texture_coords);
+	if ((diffuse_tex.a < 0.5f) || (dither_threshold(gl_FragCoord.xy) < fade_out)) { discard; }
+
+	// Specular maps are greyscale, so one channel is enough
+	albedo_specular = vec4(diffuse_tex.rgb, texture(material.texture_specular, vertex.texture_coords).r);
+	normal_shininess = vec4(normalize(vertex.normal), material.shininess);
+
+	// Alpha of 1 marks the pixel as covered for the light pass
+	position = vec4(vertex.position, 1.0f);
+}
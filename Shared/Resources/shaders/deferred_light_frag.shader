@@ -0,0 +1,75 @@
+#version 330 core
+
+struct PointLight {
+    lowp vec3 position;
+	lowp vec3 light_colour;
+
+    lowp float constant_val;
+    lowp float linear_val;
+    lowp float quadratic;
+
+    lowp vec3 ambient;
+    mediump vec3 diffuse;
+    lowp vec3 specular;
+};
+
+out vec4 colour;
+
+uniform sampler2D g_albedo_specular;
+uniform sampler2D g_normal_shininess;
+uniform sampler2D g_position;
+uniform samplerCube depth_map;
+
+uniform PointLight light;
+uniform vec3 view_position;
+uniform vec2 screen_size;
+uniform float far_plane;
+
+// QUALITY_TIER, SHADOWS and LIGHT_COLOUR are defined by LightMapProgram for each variant, SHADOWS only while drawing the first light
+#include "shadow_filter.shader"
+
+void main() {
+	vec2 texture_coords = gl_FragCoord.xy / screen_size;
+
+	vec4 position_sample = texture(g_position, texture_coords);
+	if (position_sample.a == 0.0f) { discard; }	// Nothing was drawn here in the geometry pass
+
+	vec4 albedo_specular = texture(g_albedo_specular, texture_coords);
+	vec4 normal_shininess = texture(g_normal_shininess, texture_coords);
+
+	vec3 position = position_sample.xyz;
+	vec3 normal = normalize(normal_shininess.xyz);
+	vec3 view_dir = normalize(view_position - position);
+
+	lowp vec3 light_delta = light.position - position;
+    lowp vec3 light_direction = normalize(light_delta);
+
+	// Diffusion
+	lowp float diffusion_factor = max(dot(normal, light_direction), 0.0f);
+
+	// Reflection (Specular Shading)
+	lowp vec3 reflection_direction = normalize(light_direction + view_dir);
+	lowp float specular_factor = pow(max(dot(view_dir, reflection_direction), 0.0f), normal_shininess.a);
+
+	// Attenuation
+	lowp float distance_val = length(light_delta);
+	lowp float attenuation = 1.0f / (light.constant_val + light.linear_val * distance_val + light.quadratic * (distance_val * distance_val));
+
+	// Phong combination + Add attenuation
+	lowp vec3 return_ambience = light.ambient * albedo_specular.rgb * attenuation;
+	lowp vec3 return_diffusion = light.diffuse * diffusion_factor * albedo_specular.rgb * attenuation;
+	lowp vec3 return_specular = light.specular * specular_factor * albedo_specular.a * attenuation;
+
+#ifdef LIGHT_COLOUR
+    return_ambience *= light.light_colour;
+    return_diffusion *= light.light_colour;
+    return_specular *= light.light_colour;
+#endif
+
+#ifdef SHADOWS
+	lowp float shadow_factor = shadow_calculation(position, normal, light.position);
+#else
+	lowp float shadow_factor = 0.0f;
+#endif
+	colour = vec4(return_ambience + (1.0f - shadow_factor) * (return_diffusion + return_specular), 1.0f);
+}
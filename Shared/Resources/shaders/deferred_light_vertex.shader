@@ -0,0 +1,18 @@
+#version 330 core
+
+layout (location = 0) in vec3 position;
+
+uniform mat4 VP;
+uniform mat4 model;
+uniform bool fullscreen;	// Drawn with RenderTarget::draw_fullscreen() rather than the light's volume
+
+void main() {
+	if (fullscreen) {
+		// Single triangle covering the screen, as in deferred_composite_vertex.shader
+		vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+		gl_Position = vec4(corner * 2.0f - 1.0f, 0.0f, 1.0f);
+		return;
+	}
+
+	gl_Position = VP * model * vec4(position, 1.0f);
+}
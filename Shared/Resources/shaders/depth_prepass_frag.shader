@@ -0,0 +1,5 @@
+#version 330 core
+
+// Depth only, colour writes are masked off while this program is in use
+void main() {
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+layout (location = 0) in vec3 position;
+
+uniform mat4 VP;
+uniform mat4 model;
+
+// Must match shape_light_vertex.shader exactly so the lit pass can depth test with GL_LEQUAL
+invariant gl_Position;
+
+void main() {
+	gl_Position = VP * model * vec4(position, 1.0f);
+}
@@ -0,0 +1,138 @@
+#version 330 core
+
+in vec2 texture_coords;
+
+out vec4 colour;
+
+uniform sampler2D scene;
+uniform vec2 inverse_screen_size;
+
+// Thresholds and search steps follow the 'quality' preset of FXAA 3.11
+const float EDGE_THRESHOLD_MIN = 0.0312f;
+const float EDGE_THRESHOLD_MAX = 0.125f;
+const float SUBPIXEL_QUALITY = 0.75f;
+
+const int SEARCH_STEPS = 12;
+const float STEP_SIZES[SEARCH_STEPS] = float[](1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.5f, 2.0f, 2.0f, 2.0f, 2.0f, 4.0f, 8.0f);
+
+// Colours are written without any gamma correction, so they are already perceptual
+float luma(vec3 rgb) {
+	return dot(rgb, vec3(0.299f, 0.587f, 0.114f));
+}
+
+float sample_luma(vec2 coords) {
+	return luma(textureLod(scene, coords, 0.0f).rgb);
+}
+
+// Neighbouring pixel, offset in whole pixels
+float neighbour_luma(vec2 offset) {
+	return sample_luma(texture_coords + (offset * inverse_screen_size));
+}
+
+void main() {
+	vec3 centre_colour = textureLod(scene, texture_coords, 0.0f).rgb;
+
+	float luma_centre = luma(centre_colour);
+	float luma_down = neighbour_luma(vec2(0, -1));
+	float luma_up = neighbour_luma(vec2(0, 1));
+	float luma_left = neighbour_luma(vec2(-1, 0));
+	float luma_right = neighbour_luma(vec2(1, 0));
+
+	float luma_min = min(luma_centre, min(min(luma_down, luma_up), min(luma_left, luma_right)));
+	float luma_max = max(luma_centre, max(max(luma_down, luma_up), max(luma_left, luma_right)));
+	float luma_range = luma_max - luma_min;
+
+	// Flat areas are left alone, which is most of the screen
+	if (luma_range < max(EDGE_THRESHOLD_MIN, luma_max * EDGE_THRESHOLD_MAX)) {
+		colour = vec4(centre_colour, 1.0f);
+		return;
+	}
+
+	float luma_down_left = neighbour_luma(vec2(-1, -1));
+	float luma_up_right = neighbour_luma(vec2(1, 1));
+	float luma_up_left = neighbour_luma(vec2(-1, 1));
+	float luma_down_right = neighbour_luma(vec2(1, -1));
+
+	float luma_down_up = luma_down + luma_up;
+	float luma_left_right = luma_left + luma_right;
+	float luma_left_corners = luma_down_left + luma_up_left;
+	float luma_down_corners = luma_down_left + luma_down_right;
+	float luma_right_corners = luma_down_right + luma_up_right;
+	float luma_up_corners = luma_up_right + luma_up_left;
+
+	// Whether the edge runs horizontally or vertically
+	float edge_horizontal = abs(-2.0f * luma_left + luma_left_corners) + (abs(-2.0f * luma_centre + luma_down_up) * 2.0f) + abs(-2.0f * luma_right + luma_right_corners);
+	float edge_vertical = abs(-2.0f * luma_up + luma_up_corners) + (abs(-2.0f * luma_centre + luma_left_right) * 2.0f) + abs(-2.0f * luma_down + luma_down_corners);
+	bool is_horizontal = edge_horizontal >= edge_vertical;
+
+	// Which side of the pixel the edge is on
+	float luma_negative = is_horizontal ? luma_down : luma_left;
+	float luma_positive = is_horizontal ? luma_up : luma_right;
+	float gradient_negative = luma_negative - luma_centre;
+	float gradient_positive = luma_positive - luma_centre;
+
+	bool is_negative_steepest = abs(gradient_negative) >= abs(gradient_positive);
+	float gradient_scaled = 0.25f * max(abs(gradient_negative), abs(gradient_positive));
+
+	float step_length = is_horizontal ? inverse_screen_size.y : inverse_screen_size.x;
+	float luma_local_average;
+
+	if (is_negative_steepest) {
+		step_length = -step_length;
+		luma_local_average = 0.5f * (luma_negative + luma_centre);
+	} else {
+		luma_local_average = 0.5f * (luma_positive + luma_centre);
+	}
+
+	// Start half a pixel onto the edge, then walk along it in both directions until its ends are found
+	vec2 edge_coords = texture_coords;
+	if (is_horizontal) { edge_coords.y += step_length * 0.5f; }
+	else { edge_coords.x += step_length * 0.5f; }
+
+	vec2 edge_step = is_horizontal ? vec2(inverse_screen_size.x, 0.0f) : vec2(0.0f, inverse_screen_size.y);
+	vec2 coords_negative = edge_coords - edge_step;
+	vec2 coords_positive = edge_coords + edge_step;
+
+	float luma_end_negative = sample_luma(coords_negative) - luma_local_average;
+	float luma_end_positive = sample_luma(coords_positive) - luma_local_average;
+	bool reached_negative = abs(luma_end_negative) >= gradient_scaled;
+	bool reached_positive = abs(luma_end_positive) >= gradient_scaled;
+
+	for (int search = 1; (search < SEARCH_STEPS) && !(reached_negative && reached_positive); ++search) {
+		if (!reached_negative) {
+			coords_negative -= edge_step * STEP_SIZES[search];
+			luma_end_negative = sample_luma(coords_negative) - luma_local_average;
+			reached_negative = abs(luma_end_negative) >= gradient_scaled;
+		}
+
+		if (!reached_positive) {
+			coords_positive += edge_step * STEP_SIZES[search];
+			luma_end_positive = sample_luma(coords_positive) - luma_local_average;
+			reached_positive = abs(luma_end_positive) >= gradient_scaled;
+		}
+	}
+
+	float distance_negative = is_horizontal ? (texture_coords.x - coords_negative.x) : (texture_coords.y - coords_negative.y);
+	float distance_positive = is_horizontal ? (coords_positive.x - texture_coords.x) : (coords_positive.y - texture_coords.y);
+
+	bool is_negative_closer = distance_negative < distance_positive;
+	float distance_closest = min(distance_negative, distance_positive);
+	float edge_length = distance_negative + distance_positive;
+
+	// Only blend towards the closer end if its luma variation agrees with the centre's
+	bool is_centre_smaller = luma_centre < luma_local_average;
+	bool correct_variation = ((is_negative_closer ? luma_end_negative : luma_end_positive) < 0.0f) != is_centre_smaller;
+	float pixel_offset = correct_variation ? (-distance_closest / edge_length + 0.5f) : 0.0f;
+
+	// Sub-pixel aliasing (single pixel details) is smoothed with the 3x3 average
+	float luma_average = (1.0f / 12.0f) * (2.0f * (luma_down_up + luma_left_right) + luma_left_corners + luma_right_corners);
+	float subpixel_offset = clamp(abs(luma_average - luma_centre) / luma_range, 0.0f, 1.0f);
+	subpixel_offset = (-2.0f * subpixel_offset + 3.0f) * subpixel_offset * subpixel_offset;
+	pixel_offset = max(pixel_offset, subpixel_offset * subpixel_offset * SUBPIXEL_QUALITY);
+
+	vec2 final_coords = texture_coords;
+	if (is_horizontal) { final_coords.y += pixel_offset * step_length; }
+	else { final_coords.x += pixel_offset * step_length; }
+
+	colour = vec4(textureLod(scene, final_coords, 0.0f).rgb, 1.0f);
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+in vec2 texture_coords;
+in vec3 tint;
+in float fade_out;
+
+out vec4 colour;
+
+uniform sampler2D atlas;
+
+// Must match the threshold in shape_light_frag.shader so the mesh and impostor cover each other exactly
+float dither_threshold(vec2 pixel) {
+    const float bayer[16] = float[](
+        0.0f, 8.0f, 2.0f, 10.0f,
+        12.0f, 4.0f, 14.0f, 6.0f,
+        3.0f, 11.0f, 1.0f, 9.0f,
+        15.0f, 7.0f, 13.0f, 5.0f
+    );
+
+    ivec2 index = ivec2(mod(pixel, 4.0f));
+    return (bayer[index.y * 4 + index.x] + 0.5f) / 16.0f;
+}
+
+void main() {
+    vec4 texel = texture(atlas, texture_coords);
+    if (texel.a < 0.5f) { discard; }
+
+    // The mesh keeps the pixels at or above the threshold
+    if (dither_threshold(gl_FragCoord.xy) >= fade_out) { discard; }
+
+    colour = vec4(texel.rgb * tint, 1.0f);
+}
@@ -0,0 +1,30 @@
+#version 330 core
+
+// One instance per impostor
+layout (location = 0) in vec4 centre_radius;
+layout (location = 1) in vec4 tint_fade_out;
+layout (location = 2) in float cell;
+
+out vec2 texture_coords;
+out vec3 tint;
+out float fade_out;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec2 atlas_cells;
+
+void main() {
+    // Triangle strip corners: (0, 0), (1, 0), (0, 1), (1, 1)
+    vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1);
+
+    // Offset in view space so the quad always faces the camera, sized to match the baked view
+    vec4 view_position = view * vec4(centre_radius.xyz, 1.0f);
+    view_position.xy += (corner * 2.0f - 1.0f) * centre_radius.w;
+    gl_Position = projection * view_position;
+
+    vec2 cell_origin = vec2(mod(cell, atlas_cells.x), floor(cell / atlas_cells.x));
+    texture_coords = (cell_origin + corner) / atlas_cells;
+
+    tint = tint_fade_out.rgb;
+    fade_out = tint_fade_out.a;
+}
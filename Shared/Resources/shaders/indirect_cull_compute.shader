@@ -0,0 +1,54 @@
+#version 430 core
+
+// Only loaded when the context is 4.3 or newer, see IndirectRenderer
+
+layout (local_size_x = 64) in;
+
+// Must match IndirectRenderer::Object
+struct Object {
+    mat4 model;
+    vec4 bounds;    // Local bounding sphere, xyz is the centre and w the radius
+    uvec4 range;    // First index, index count and base vertex of the chosen level of detail
+};
+
+// Must match IndirectRenderer::DrawCommand (the layout glMultiDrawElementsIndirect reads)
+struct DrawCommand {
+    uint count;
+    uint instance_count;
+    uint first_index;
+    int base_vertex;
+    uint base_instance;
+};
+
+layout (std430, binding = 0) readonly buffer Objects {
+    Object objects[];
+};
+
+layout (std430, binding = 1) writeonly buffer Commands {
+    DrawCommand commands[];
+};
+
+uniform int object_count;
+uniform vec4 planes[6];    // Unnormalised, xyz facing into the frustum
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= uint(object_count)) { return; }
+
+    Object object = objects[index];
+    vec3 centre = vec3(object.model * vec4(object.bounds.xyz, 1.0f));
+    float scale = max(length(object.model[0].xyz), max(length(object.model[1].xyz), length(object.model[2].xyz)));
+    float radius = object.bounds.w * scale;
+
+    bool visible = true;
+    for (int i = 0; i < 6; ++i) {
+        if (dot(planes[i].xyz, centre) + planes[i].w < -radius * length(planes[i].xyz)) { visible = false; }
+    }
+
+    // Culled objects keep their command, drawing no instances, so every command stays at its object's index
+    commands[index].count = object.range.y;
+    commands[index].instance_count = visible ? 1u : 0u;
+    commands[index].first_index = object.range.x;
+    commands[index].base_vertex = int(object.range.z);
+    commands[index].base_instance = index;
+}
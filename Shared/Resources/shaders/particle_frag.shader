@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 corner;
+in vec4 particle_colour;
+
+out vec4 colour;
+
+void main() {
+    float distance_squared = dot(corner, corner);
+    if (distance_squared > 1.0f) { discard; }
+
+    colour = vec4(particle_colour.rgb, particle_colour.a * (1.0f - distance_squared));
+}
@@ -0,0 +1,56 @@
+#version 330 core
+
+#define MAX_EMITTERS 32	// Must match ParticleSystem::MAX_EMITTERS
+
+struct Emitter {
+    vec3 position;
+    vec3 velocity;
+    float spread;
+    float lifetime;
+    float gravity;
+    float emit_until;
+};
+
+layout (location = 0) in vec4 position_life;
+layout (location = 1) in vec4 velocity_start_life;
+
+// Captured by transform feedback
+out vec4 out_position_life;
+out vec4 out_velocity_start_life;
+
+uniform Emitter emitters[MAX_EMITTERS];
+uniform int particles_per_emitter;
+uniform float time;
+uniform float time_delta;
+
+float random(float seed) {
+    return fract(sin(seed * 12.9898f + time * 78.233f) * 43758.5453f);
+}
+
+void main() {
+    Emitter emitter = emitters[gl_VertexID / particles_per_emitter];
+
+    vec3 position = position_life.xyz;
+    float life = position_life.w;
+    vec3 velocity = velocity_start_life.xyz;
+    float start_life = velocity_start_life.w;
+
+    if (life > 0.0f) {
+        life -= time_delta;
+        velocity.y -= emitter.gravity * time_delta;
+        position += velocity * time_delta;
+
+    } else if (time < emitter.emit_until) {
+        // Dead particles respawn straight away while their emitter is active
+        float seed = float(gl_VertexID);
+        vec3 direction = vec3(random(seed), random(seed + 1.0f), random(seed + 2.0f)) * 2.0f - 1.0f;
+
+        position = emitter.position;
+        velocity = emitter.velocity + direction * emitter.spread;
+        start_life = emitter.lifetime * (0.5f + 0.5f * random(seed + 3.0f));
+        life = start_life;
+    }
+
+    out_position_life = vec4(position, life);
+    out_velocity_start_life = vec4(velocity, start_life);
+}
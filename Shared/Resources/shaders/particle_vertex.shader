@@ -0,0 +1,40 @@
+#version 330 core
+
+#define MAX_EMITTERS 32	// Must match ParticleSystem::MAX_EMITTERS
+
+struct Emitter {
+    vec3 colour;
+    float size;
+};
+
+// One instance per particle
+layout (location = 0) in vec4 position_life;
+layout (location = 1) in vec4 velocity_start_life;
+
+out vec2 corner;
+out vec4 particle_colour;
+
+uniform Emitter emitters[MAX_EMITTERS];
+uniform int particles_per_emitter;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    if (position_life.w <= 0.0f) {
+        // Dead particles are placed outside the clip volume so they are discarded before rasterisation
+        gl_Position = vec4(0.0f, 0.0f, 2.0f, 1.0f);
+        return;
+    }
+
+    Emitter emitter = emitters[gl_InstanceID / particles_per_emitter];
+
+    // Triangle strip corners: (-1, -1), (1, -1), (-1, 1), (1, 1)
+    corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1) * 2.0f - 1.0f;
+
+    // Offset in view space so the quad always faces the camera
+    vec4 view_position = view * vec4(position_life.xyz, 1.0f);
+    view_position.xy += corner * emitter.size;
+
+    gl_Position = projection * view_position;
+    particle_colour = vec4(emitter.colour, position_life.w / velocity_start_life.w);
+}
@@ -0,0 +1,39 @@
+// Percentage closer filtering of the first light's cube shadow map, shared by the forward and deferred lit shaders
+// Included after 'view_position', 'far_plane' and 'depth_map' are declared, QUALITY_TIER is defined by LightMapProgram
+
+#if (QUALITY_TIER == 0)
+	const lowp int SAMPLE_SIZE = 4;
+#elif (QUALITY_TIER == 1)
+	const lowp int SAMPLE_SIZE = 8;
+#else
+	const lowp int SAMPLE_SIZE = 20;
+#endif
+
+const lowp vec3 sample_disk[20] = vec3[](
+   vec3(1, 1, 1),	vec3(1, -1, 1),		vec3(-1, -1, 1),	vec3(-1, 1, 1), 
+   vec3(1, 1, -1),	vec3(1, -1, -1),	vec3(-1, -1, -1),	vec3(-1, 1, -1),
+   vec3(1, 1, 0),	vec3(1, -1, 0),		vec3(-1, -1, 0),	vec3(-1, 1, 0),
+   vec3(1, 0, 1),	vec3(-1, 0, 1),		vec3(1, 0, -1),		vec3(-1, 0, -1),
+   vec3(0, 1, 1),	vec3(0, -1, 1),		vec3(0, -1, -1),	vec3(0, 1, -1)
+);
+
+// Fraction of the taps in shadow, from 0 (lit) to 1
+float shadow_calculation(vec3 position, vec3 normal, vec3 light_position) {
+    lowp vec3 frag_to_light_vec = position - light_position;
+    lowp float current_depth = length(frag_to_light_vec);
+
+    lowp float shadow_result = 0.0f;
+    lowp float bias = max(0.05f * (1.0f - dot(normal, normalize(light_position - position))), 0.5f);
+    lowp float view_distance = length(view_position - position);
+    lowp float disk_radius = (1.0f + (view_distance / far_plane)) / 50.0f;
+
+    for(int sample_iter = 0; sample_iter < SAMPLE_SIZE; ++sample_iter){
+        float closest_depth = texture(depth_map, frag_to_light_vec + sample_disk[sample_iter] * disk_radius).r;
+        closest_depth *= far_plane;	// Undo linear mapping
+
+        if((current_depth - bias) > closest_depth){ shadow_result += 1.0f; }
+    }
+
+    shadow_result /= float(SAMPLE_SIZE);
+    return shadow_result;
+}
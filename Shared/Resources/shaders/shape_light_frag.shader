@@ -19,7 +19,7 @@ struct PointLight {
     lowp vec3 specular;
 };
 
-#define LIGHT_COUNT $	// Where '$' will be replaced dynamically in C++ part of program
+// LIGHT_COUNT, QUALITY_TIER, SHADOWS, LIGHT_COLOUR and DITHER_FADE are defined by LightMapProgram for each variant
 #if (LIGHT_COUNT > 0)
     // If this is not done, a null light could cause negative-infinity brightness (yikes)
     uniform PointLight lights[LIGHT_COUNT];	// Array of PointLight objects
@@ -37,38 +37,25 @@ uniform vec3 view_position;
 uniform float far_plane;
 uniform CustomMaterial material;
 uniform samplerCube depth_map;
-uniform bool use_shadows;
-uniform bool use_light_colour;
-
-const lowp int SAMPLE_SIZE = 20;
-const lowp vec3 sample_disk[SAMPLE_SIZE] = vec3[](
-   vec3(1, 1, 1),	vec3(1, -1, 1),		vec3(-1, -1, 1),	vec3(-1, 1, 1), 
-   vec3(1, 1, -1),	vec3(1, -1, -1),	vec3(-1, -1, -1),	vec3(-1, 1, -1),
-   vec3(1, 1, 0),	vec3(1, -1, 0),		vec3(-1, -1, 0),	vec3(-1, 1, 0),
-   vec3(1, 0, 1),	vec3(-1, 0, 1),		vec3(1, 0, -1),		vec3(-1, 0, -1),
-   vec3(0, 1, 1),	vec3(0, -1, 1),		vec3(0, -1, -1),	vec3(0, 1, -1)
-);
-
-float shadow_calculation(const PointLight light) {
-    lowp vec3 frag_to_light_vec = vertex.position - light.position;
-    lowp float current_depth = length(frag_to_light_vec);
-
-	// PFC Testing
-    lowp  float shadow_result = 0.0f;
-    lowp float bias = max(0.05f * (1.0f - dot(vertex.normal, normalize(light.position - vertex.position))), 0.5f);
-    lowp  float view_distance = length(view_position - vertex.position);
-    lowp float disk_radius = (1.0f + (view_distance / far_plane)) / 50.0f;
-
-    for(int sample_iter = 0; sample_iter < SAMPLE_SIZE; ++sample_iter){
-        float closest_depth = texture(depth_map, frag_to_light_vec + sample_disk[sample_iter] * disk_radius).r;
-        closest_depth *= far_plane;	// Undo linear mapping
-
-        if((current_depth - bias) > closest_depth){ shadow_result += 1.0f; }
+
+#ifdef DITHER_FADE
+    // Fraction of the surface handed over to its impostor, see impostor_frag.shader
+    uniform float fade_out;
+
+    float dither_threshold(vec2 pixel) {
+        const float bayer[16] = float[](
+            0.0f, 8.0f, 2.0f, 10.0f,
+            12.0f, 4.0f, 14.0f, 6.0f,
+            3.0f, 11.0f, 1.0f, 9.0f,
+            15.0f, 7.0f, 13.0f, 5.0f
+        );
+
+        ivec2 index = ivec2(mod(pixel, 4.0f));
+        return (bayer[index.y * 4 + index.x] + 0.5f) / 16.0f;
     }
+#endif
 
-    shadow_result /= float(SAMPLE_SIZE);
-    return shadow_result;
-}
+#include "shadow_filter.shader"
 
 vec3 calculate_point(PointLight light, CustomMaterial material, vec3 normal, vec3 view_dir, int index){
 	lowp vec3 light_delta = light.position - vertex.position;
@@ -97,25 +84,29 @@ vec3 calculate_point(PointLight light, CustomMaterial material, vec3 normal, vec
 	lowp vec3 return_diffusion = light.diffuse * diffusion_factor * diffuse_tex * attenuation;
 	lowp vec3 return_specular =	light.specular * specular_factor * spec_tex * attenuation;
 
-    // Add light colour if enabled
-    if (use_light_colour){
-        return_ambience *= light.light_colour;
-        return_diffusion *= light.light_colour;
-        return_specular *= light.light_colour;
-    }
+#ifdef LIGHT_COLOUR
+    return_ambience *= light.light_colour;
+    return_diffusion *= light.light_colour;
+    return_specular *= light.light_colour;
+#endif
 
-	if ((index == 0) && (use_shadows)){
-		lowp float shadow_factor = shadow_calculation(light);
+#ifdef SHADOWS
+	if (index == 0){
+		lowp float shadow_factor = shadow_calculation(vertex.position, vertex.normal, light.position);
 		lowp vec3 lighting = (return_ambience + (1.0f - shadow_factor) * (return_diffusion + return_specular));
 		return lighting;
-
-	} else {
-		lowp vec3 value = (return_ambience + return_diffusion + return_specular);
-        return value;
 	}
+#endif
+
+	lowp vec3 value = (return_ambience + return_diffusion + return_specular);
+    return value;
 }
 
 void main() {   
+#ifdef DITHER_FADE
+    if (dither_threshold(gl_FragCoord.xy) < fade_out) { discard; }
+#endif
+
 	highp vec3 result = vec3(0.0f);
 
 #if (LIGHT_COUNT > 0)
@@ -2,8 +2,9 @@
 layout (triangles) in;
 layout (triangle_strip, max_vertices=3) out;
 
+// Only attached to the GEOMETRY_EXPLODE variant of the lit program
+
 uniform float time;
-uniform bool do_explode;
 
 in Vertex {
     vec3 position;
@@ -17,6 +18,8 @@ out Vertex {
     vec2 texture_coords;
 } vertex;
 
+invariant gl_Position;
+
 vec3 get_normal(){
     vec3 a = vec3(gl_in[0].gl_Position) - vec3(gl_in[1].gl_Position);
     vec3 b = vec3(gl_in[2].gl_Position) - vec3(gl_in[1].gl_Position);
@@ -31,13 +34,7 @@ vec4 explode(vec4 position, vec3 normal){
 
 void main(){
     for (int i = 0; i < gl_in.length(); ++i){
-		vec4 pos = gl_in[i].gl_Position;
-
-		if (do_explode){
-			pos = explode(gl_in[i].gl_Position, get_normal());
-		}
-
-		gl_Position = pos;
+		gl_Position = explode(gl_in[i].gl_Position, get_normal());
 
         vertex.position = vertex_in[i].position;
         vertex.normal = vertex_in[i].normal;
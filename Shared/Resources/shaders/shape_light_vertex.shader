@@ -11,9 +11,22 @@ out Vertex {
 } vertex_in;
 
 uniform mat4 VP;
+
+#ifdef INDIRECT
+// One per draw command, the command's base instance selects the object
+layout (location = 3) in mat4 object_model;
+#else
 uniform mat4 model;
+#endif
+
+// Must match depth_prepass_vertex.shader exactly so the depth pre-pass lines up
+invariant gl_Position;
 
 void main() {
+#ifdef INDIRECT
+	mat4 model = object_model;
+#endif
+
 	gl_Position = VP * model * vec4(position, 1.0f);
 
 	vertex_in.position = vec3(model * vec4(position, 1.0f));
@@ -0,0 +1,45 @@
+#include "MapFile.hpp"
+
+/*
+Writes Shared/Resources/maps/ORIGINAL.map, the grid GameScene loads, which is otherwise only kept as binary
+
+Built on its own against the game's and engine's headers, with Shared/MapFile.cpp as its only other source, then run
+with the path to write to (the repository's copy when none is given)
+
+No connected components are stored, as the terrain's navigation mesh adds walls once the game has loaded it and they
+would always be worked out again. Maps whose walls are all in the file can store them with MapFile::set_components
+*/
+
+namespace {
+	const int X_LOWER_BOUND = -90;
+	const int Z_LOWER_BOUND = -90;
+	const UInt WIDTH = 93;		// Up to x = 94
+	const UInt DEPTH = 92;		// Up to z = 92
+	const int SPACING = 2;
+
+	const SpawnZone SPAWN_ZONE = { -80.0f, -80.0f, 80.0f, 80.0f };
+}
+
+int main(int argc, char* argv[]) {
+	const std::string full_path = (argc >= 2) ? argv[1] : "Shared/Resources/maps/ORIGINAL.map";
+
+	try {
+		MapFile file(X_LOWER_BOUND, Z_LOWER_BOUND, WIDTH, DEPTH, SPACING);
+
+		// Only the border is walled, everything inside is left to the terrain
+		for (size_t x = 0; x < WIDTH; ++x) {
+			for (size_t y = 0; y < DEPTH; ++y) {
+				if ((x == 0) || (y == 0) || (x == (WIDTH - 1)) || (y == (DEPTH - 1))) { file.set_wall(x, y, true); }
+			}
+		}
+
+		file.add_spawn_zone(SPAWN_ZONE);
+		file.save(full_path);
+
+	} catch (const std::runtime_error& exception) {
+		std::cout << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}